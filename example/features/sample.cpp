@@ -0,0 +1,40 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract.hpp>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+//[sample
+// Contract too expensive to check for every call (linear complexity).
+void insert_sorted(std::vector<int>& v, int x) {
+    static boost::contract::sampling insert_sorted_sampling(100); // 1 in 100.
+    boost::contract::sample sampled(insert_sorted_sampling);
+    boost::contract::old_ptr<std::vector<int>::size_type> old_size =
+            BOOST_CONTRACT_OLDOF(v.size());
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            BOOST_CONTRACT_ASSERT(std::is_sorted(v.begin(), v.end()));
+        })
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(v.size() == *old_size + 1);
+            BOOST_CONTRACT_ASSERT(std::is_sorted(v.begin(), v.end()));
+        })
+    ;
+
+    v.insert(std::upper_bound(v.begin(), v.end(), x), x); // Function body.
+}
+//]
+
+int main() {
+    std::vector<int> v;
+    for(int i = 0; i < 1000; ++i) insert_sorted(v, (i * 7) % 31);
+    assert(v.size() == 1000);
+    assert(std::is_sorted(v.begin(), v.end()));
+    return 0;
+}
+
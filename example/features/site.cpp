@@ -0,0 +1,54 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract.hpp>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+
+//[site
+int find_sorted(std::vector<int> const& v, int x) {
+    int result;
+    BOOST_CONTRACT_SITE(find_sorted_site); // Enabled by default.
+    boost::contract::sample sampled(find_sorted_site);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            BOOST_CONTRACT_ASSERT(std::is_sorted(v.begin(), v.end()));
+        })
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(result == -1 || v[result] == x);
+        })
+    ;
+
+    std::vector<int>::const_iterator i =
+            std::lower_bound(v.begin(), v.end(), x);
+    return result = (i != v.end() && *i == x) ? int(i - v.begin()) : -1;
+}
+
+void list_sites() {
+    for(boost::contract::site* s = boost::contract::site::first(); s;
+            s = s->next()) {
+        std::cout << s->file() << ":" << s->line() << ": " << s->function() <<
+                (s->enabled() ? "" : " (disabled)") << std::endl;
+    }
+}
+//]
+
+int main() {
+    std::vector<int> v;
+    for(int i = 0; i < 10; ++i) v.push_back(i * 2);
+    assert(find_sorted(v, 4) == 2);
+    list_sites();
+
+    // Stop checking all contracts in this file (e.g., too expensive).
+    assert(boost::contract::disable_sites("site.cpp") == 1);
+    std::reverse(v.begin(), v.end()); // Precondition would fail.
+    find_sorted(v, 4);
+    list_sites();
+    return 0;
+}
+
@@ -0,0 +1,35 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract.hpp>
+#include <limits>
+#include <cassert>
+
+//[typed_function
+int inc(int& x) {
+    int result;
+    boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(x);
+    auto c = boost::contract::typed_function() // Use `auto` (not `check`).
+        .precondition([&] {
+            BOOST_CONTRACT_ASSERT(x < std::numeric_limits<int>::max());
+        })
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+            BOOST_CONTRACT_ASSERT(result == *old_x);
+        })
+    ;
+
+    return result = x++; // Function body.
+}
+//]
+
+int main() {
+    int x = 10;
+    assert(inc(x) == 10);
+    assert(x == 11);
+    return 0;
+}
+
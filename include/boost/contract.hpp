@@ -19,6 +19,9 @@ Instead the headers <c>boost/contract/core/\*.hpp</c> are not independent from
 other library headers and they are automatically included by the
 <c>boost/contract/\*.hpp</c> headers (so the <c>boost/contract/core/\*.hpp</c>
 headers are usually not directly included by programmers).
+Headers of features enabled by configuration macros (e.g.,
+@RefMacro{BOOST_CONTRACT_METRICS}) are included by this header only when their
+macros are defined (but they can always be included one-by-one).
 
 All files under the <c>boost/contract/detail/</c> directory, names within the
 @c boost::contract::detail namespace, names prefixed with
@@ -35,10 +38,25 @@ never be used directly by programmers.
 #include <boost/contract/constructor.hpp>
 #include <boost/contract/destructor.hpp>
 #include <boost/contract/function.hpp>
+#include <boost/contract/typed_function.hpp>
 #include <boost/contract/check.hpp>
 #include <boost/contract/old.hpp>
 #include <boost/contract/override.hpp>
 #include <boost/contract/public_function.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/scoped_policy.hpp>
+#include <boost/contract/budget.hpp>
+#include <boost/contract/site.hpp>
+#ifdef BOOST_CONTRACT_METRICS
+    #include <boost/contract/metrics.hpp>
+    #include <boost/contract/metrics_exporter.hpp>
+#endif
+#ifdef BOOST_CONTRACT_TRACE
+    #include <boost/contract/trace.hpp>
+#endif
+#ifdef BOOST_CONTRACT_OBSERVER
+    #include <boost/contract/observer.hpp>
+#endif
 
 #endif // #include guard
 
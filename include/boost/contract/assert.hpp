@@ -61,6 +61,56 @@ Assert contract conditions.
         BOOST_CONTRACT_DETAIL_NOOP
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert contract conditions only when the assertion level set at run-time is
+    greater than or equal to the specified level.
+
+    The asserted condition will always be compiled and validated syntactically,
+    but it will be checked at run-time only if @p level is less than or equal to
+    the value returned by @RefFunc{boost::contract::get_assertion_level} when
+    this assertion is reached (see that function for the cost of this check).
+    This macro is defined by code equivalent to:
+
+    @code
+        #define BOOST_CONTRACT_ASSERT_LEVEL(level, cond) \
+            if((level) <= boost::contract::get_assertion_level()) \
+                BOOST_CONTRACT_ASSERT(cond); \
+            else \
+                BOOST_CONTRACT_ASSERT(true || cond)
+    @endcode
+
+    This can be used to program assertion levels other than the ones predefined
+    by this library (see @RefEnum{boost::contract::assertion_level}), all of
+    which can then be enabled or disabled at run-time without recompiling code.
+
+    @see @RefSect{extras.assertion_levels, Assertion Levels}
+
+    @param level    Assertion level (this is usually
+                    @RefEnum{boost::contract::assertion_level} but it can be any
+                    other numeric level).
+    @param cond Boolean contract condition to check.
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_ASSERT_LEVEL(level, (cond)) will always
+                work.)
+    */
+    #define BOOST_CONTRACT_ASSERT_LEVEL(level, cond)
+#elif !defined(BOOST_CONTRACT_NO_ALL)
+    #include <boost/contract/core/assertion_level.hpp>
+    #define BOOST_CONTRACT_ASSERT_LEVEL(level, cond) \
+        /* no if-statement here (see BOOST_CONTRACT_DETAIL_ASSERT) */ \
+        ((level) <= boost::contract::get_assertion_level() ? \
+            BOOST_CONTRACT_ASSERT(cond) \
+        : \
+            BOOST_CONTRACT_DETAIL_NOOP \
+        ) /* no ; here */
+#else
+    #include <boost/contract/core/assertion_level.hpp>
+    #define BOOST_CONTRACT_ASSERT_LEVEL(level, cond) \
+        BOOST_CONTRACT_DETAIL_NOEVAL(cond)
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Preferred way to assert contract conditions that are computationally
@@ -68,7 +118,9 @@ Assert contract conditions.
 
     The asserted condition will always be compiled and validated syntactically,
     but it will not be checked at run-time unless
-    @RefMacro{BOOST_CONTRACT_AUDITS} is defined (undefined by default).
+    @RefMacro{BOOST_CONTRACT_AUDITS} is defined (undefined by default) or the
+    assertion level set at run-time is audit or greater (see
+    @RefFunc{boost::contract::set_assertion_level}).
     This macro is defined by code equivalent to:
 
     @code
@@ -77,7 +129,8 @@ Assert contract conditions.
                 BOOST_CONTRACT_ASSERT(cond)
         #else
             #define BOOST_CONTRACT_ASSERT_AUDIT(cond) \
-                BOOST_CONTRACT_ASSERT(true || cond)
+                BOOST_CONTRACT_ASSERT_LEVEL( \
+                        boost::contract::assertion_level_audit, cond)
         #endif
     @endcode
 
@@ -100,7 +153,7 @@ Assert contract conditions.
         BOOST_CONTRACT_ASSERT(cond)
 #else
     #define BOOST_CONTRACT_ASSERT_AUDIT(cond) \
-        BOOST_CONTRACT_DETAIL_NOEVAL(cond)
+        BOOST_CONTRACT_ASSERT_LEVEL(boost::contract::assertion_level_audit, cond)
 #endif
 
 /**
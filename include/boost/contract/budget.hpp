@@ -0,0 +1,275 @@
+
+#ifndef BOOST_CONTRACT_BUDGET_HPP_
+#define BOOST_CONTRACT_BUDGET_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Limit the fraction of time spent checking contracts.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/check_cost.hpp>
+#include <boost/contract/detail/next_contract.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/cstdint.hpp>
+
+#if     defined(BOOST_CONTRACT_DETAIL_CHECK_COST_TICKS) || \
+        defined(BOOST_CONTRACT_DETAIL_DOXYGEN)
+
+namespace boost { namespace contract {
+
+class budget_sampling;
+
+/**
+Target fraction of the program time to spend checking contracts.
+
+This is usually declared as a global or local static variable shared by the
+@RefClass{boost::contract::budget_sampling} policies of all the contracts that
+must stay within the same budget:
+
+@code
+boost::contract::budget& contracts_budget() {
+    static boost::contract::budget b(0.05); // At most 5% of time in contracts.
+    return b;
+}
+
+void f(...) {
+    static boost::contract::budget_sampling f_sampling(contracts_budget());
+    boost::contract::sample sampled(f_sampling);
+    ...
+}
+@endcode
+
+The time spent checking sampled contracts is measured using a cheap cycle
+counter (time-stamp counter on x86, steady clock otherwise) around checking
+class invariants, preconditions, old value functors, postconditions, and
+exception guarantees (but not around the subcontracted checks of overridden
+functions, which are not sampled).
+Every few sampled contracts, this object compares the measured overhead (the
+time spent checking sampled contracts divided by the number of threads that
+checked them and by the elapsed time) with its target fraction: when over
+budget, it lowers a per-check cost threshold so only contracts more expensive
+than the threshold are checked less often (the most expensive ones first); when
+well under budget (less than half the target fraction), it raises the threshold
+back.
+All state is held in atomic variables without any memory ordering constraint so
+the same object can be safely used by multiple threads.
+
+@see @RefSect{advanced.sampling_contract_checks, Sampling Contract Checks}
+*/
+class budget : // Non-copyable (atomic state).
+    private boost::noncopyable
+{
+public:
+    /**
+    Construct this object.
+
+    @param fraction Target fraction of the program time to spend checking
+                    contracts (e.g., @c 0.05 for 5%).
+                    Contracts are never throttled if this is @c 1 or more.
+    @param window   Number of sampled contracts between two consecutive
+                    evaluations of the measured overhead (at least @c 1).
+    */
+    explicit budget(double fraction, unsigned long window = 256) :
+        fraction_(to_ppb(fraction)),
+        window_(window ? window : 1),
+        checks_(0),
+        windows_(0),
+        threads_(0),
+        start_(boost::contract::detail::tick_count()),
+        spent_(0),
+        threshold_(unlimited()),
+        overhead_(0)
+    {}
+
+    /** Return the target fraction currently set. */
+    double fraction() const {
+        return from_ppb(fraction_.load(boost::memory_order_relaxed));
+    }
+
+    /**
+    Set a new target fraction (this also stops throttling contracts until the
+    measured overhead is next evaluated).
+
+    This can be called at any time, also while other threads are using this
+    object.
+    */
+    void fraction(double value) {
+        fraction_.store(to_ppb(value), boost::memory_order_relaxed);
+        threshold_.store(unlimited(), boost::memory_order_relaxed);
+    }
+
+    /**
+    Return the fraction of time spent checking contracts, as measured the last
+    time it was evaluated (zero before the first evaluation).
+    */
+    double overhead() const {
+        return from_ppb(overhead_.load(boost::memory_order_relaxed));
+    }
+
+/** @cond */
+private:
+    friend class budget_sampling;
+
+    static boost::uint64_t unlimited() {
+        return boost::integer_traits<boost::uint64_t>::const_max;
+    }
+
+    static boost::uint64_t to_ppb(double value) {
+        if(value <= 0) return 0;
+        if(value >= 1) return 1000000000u;
+        return static_cast<boost::uint64_t>(value * 1e9);
+    }
+
+    static double from_ppb(boost::uint64_t value) { return value / 1e9; }
+
+    // Contracts costing more ticks than this per check are sampled out.
+    boost::uint64_t threshold() const {
+        return threshold_.load(boost::memory_order_relaxed);
+    }
+
+    // Count a sampled contract (and evaluate overhead at end of window).
+    void checked() {
+        if(boost::contract::detail::check_threads::first(&spent_,
+                windows_.load(boost::memory_order_relaxed))) {
+            threads_.fetch_add(1, boost::memory_order_relaxed);
+        }
+        if((checks_.fetch_add(1, boost::memory_order_relaxed) + 1) %
+                window_ != 0) return;
+        // Only one thread per window gets here (so no CAS needed below).
+        windows_.fetch_add(1, boost::memory_order_relaxed);
+        boost::uint64_t const now = boost::contract::detail::tick_count();
+        boost::uint64_t const elapsed = now -
+                start_.exchange(now, boost::memory_order_relaxed);
+        boost::uint64_t const spent =
+                spent_.exchange(0, boost::memory_order_relaxed);
+        unsigned long threads = threads_.exchange(0,
+                boost::memory_order_relaxed);
+        if(threads == 0) threads = 1;
+        if(elapsed == 0) return;
+
+        // Ticks spent by all threads checking in one window of wall time.
+        double const overhead = static_cast<double>(spent) / threads / elapsed;
+        overhead_.store(to_ppb(overhead), boost::memory_order_relaxed);
+        double const target = fraction();
+        boost::uint64_t t = threshold();
+        if(target >= 1) {
+            t = unlimited();
+        } else if(overhead > target) {
+            // Start throttling contracts more expensive than average.
+            t = t == unlimited() ? spent / window_ : t / 2;
+            if(t == 0) t = 1;
+        } else if(overhead < target / 2 && t != unlimited()) {
+            // No single check can cost more than entire window.
+            t = t > elapsed / 2 ? unlimited() : t * 2;
+        }
+        threshold_.store(t, boost::memory_order_relaxed);
+    }
+
+    boost::atomic<boost::uint64_t> fraction_; // Parts per billion.
+    unsigned long const window_;
+    boost::atomic<unsigned long> checks_;
+    boost::atomic<unsigned long> windows_; // Evaluated windows.
+    boost::atomic<unsigned long> threads_; // Threads checking in window.
+    boost::atomic<boost::uint64_t> start_; // Ticks at start of window.
+    boost::atomic<boost::uint64_t> spent_; // Ticks checking in window.
+    boost::atomic<boost::uint64_t> threshold_;
+    boost::atomic<boost::uint64_t> overhead_; // Parts per billion.
+/** @endcond */
+};
+
+/**
+Sampling policy that checks contracts as often as allowed by a
+@RefClass{boost::contract::budget}.
+
+This is declared as a local static variable right before the contract
+declaration (so each contract measures its own checking cost) and passed to
+@RefClass{boost::contract::sample}:
+
+@code
+void f(...) {
+    static boost::contract::budget_sampling f_sampling(contracts_budget());
+    boost::contract::sample sampled(f_sampling);
+    boost::contract::old_ptr<old_type> old_var = BOOST_CONTRACT_OLDOF(old_expr);
+    boost::contract::check c = boost::contract::function()
+        ...
+    ;
+
+    ... // Function body.
+}
+@endcode
+
+Contracts are checked for all calls while the budget is met.
+Otherwise, contracts whose average cost per check is above the budget threshold
+are checked once every @c N calls, with @c N proportional to their cost (so
+the checking cost per call of each contract stays within the threshold).
+The call counter and measured costs are atomic variables updated without any
+memory ordering constraint, so the same object can be safely used by multiple
+threads.
+
+@see @RefSect{advanced.sampling_contract_checks, Sampling Contract Checks}
+*/
+class budget_sampling : // Non-copyable (atomic counters).
+    private boost::noncopyable
+{
+public:
+    /**
+    Construct this object.
+
+    @param b    Budget shared with other contracts (this object keeps a
+                reference to it so it must outlive this object).
+    */
+    explicit budget_sampling(budget& b) : budget_(b), cost_(&b.spent_),
+            calls_(0) {}
+
+    /**
+    Return the current sampling period (contracts checked once every this many
+    calls, @c 1 while within budget or before this contract is checked).
+    */
+    unsigned long period() const {
+        boost::uint64_t const t = budget_.threshold();
+        if(t == budget::unlimited()) return 1;
+        unsigned long const checks = cost_.checks();
+        if(checks == 0) return 1;
+        boost::uint64_t const average = cost_.ticks() / checks;
+        if(average <= t) return 1;
+        boost::uint64_t const p = (average + t - 1) / t;
+        return p < boost::integer_traits<unsigned long>::const_max ?
+                static_cast<unsigned long>(p) :
+                boost::integer_traits<unsigned long>::const_max;
+    }
+
+    /**
+    Count one more call and return true if its contract must be checked (in
+    which case the checking cost of that contract is measured).
+    */
+    bool operator()() const {
+        if(calls_.fetch_add(1, boost::memory_order_relaxed) % period() != 0) {
+            return false;
+        }
+        cost_.count();
+        budget_.checked();
+        boost::contract::detail::next_contract::ref().cost = &cost_;
+        return true;
+    }
+
+/** @cond */
+private:
+    budget& budget_;
+    mutable boost::contract::detail::check_cost cost_;
+    mutable boost::atomic<unsigned long> calls_;
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // CHECK_COST_TICKS
+
+#endif // #include guard
+
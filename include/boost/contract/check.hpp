@@ -18,7 +18,7 @@ RAII object that checks contracts.
 #if !defined(BOOST_CONTRACT_NO_CONDITIONS) || \
         defined(BOOST_CONTRACT_STATIC_LINK)
     #include <boost/contract/detail/condition/cond_base.hpp>
-    #include <boost/contract/detail/auto_ptr.hpp>
+    #include <boost/contract/detail/condition/cond_storage.hpp>
     #include <boost/contract/detail/debug.hpp>
 #endif
 #include <boost/contract/detail/check.hpp>
@@ -31,10 +31,10 @@ RAII object that checks contracts.
 #if !defined(BOOST_CONTRACT_NO_CONDITIONS) || \
         defined(BOOST_CONTRACT_STATIC_LINK)
     #define BOOST_CONTRACT_CHECK_CTOR_DEF_(contract_type) \
-        : cond_(const_cast<contract_type&>(contract).cond_.release()) \
         { \
-            BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-            cond_->initialize(); \
+            cond_.move(*contract.storage_); \
+            BOOST_CONTRACT_DETAIL_DEBUG(cond_.get()); \
+            cond_.get()->initialize(); \
         }
 #else
     #define BOOST_CONTRACT_CHECK_CTOR_DEF_(contract_type) {}
@@ -76,7 +76,7 @@ to program implementation checks.
 @see    @RefSect{tutorial, Tutorial},
         @RefSect{advanced.implementation_checks, Implementation Checks}
 */
-class check { // Copy ctor only (as move via ptr release).
+class check { // Move ctor only (moves contract object storage).
 public:
     // NOTE: Unfortunately, Apple compilers define a `check(...)` macro that
     // clashes with the name of this class. In the following code,
@@ -112,22 +112,33 @@ public:
     }
 
     /**
-    Construct this object copying it from the specified one.
+    Construct this object moving it from the specified one.
 
-    This object will check the contract, the copied-from object will not (i.e.,
-    contract check ownership is transferred from the copied object to the new
-    object being created by this constructor).
+    This object will check the contract, the moved-from object will not (i.e.,
+    contract check ownership is transferred from the moved-from object to the
+    new object being created by this constructor).
+    On compilers that do not support C++11 rvalue references, this is a copy
+    constructor taking <c>check const&</c> that still transfers ownership.
 
-    @param other    Copied-from object.
+    @param other    Moved-from object.
     */
     check /** @cond **/ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ (
-            check const& other)
+        #if     !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) || \
+                defined(BOOST_CONTRACT_DETAIL_DOXYGEN)
+            check&& other
+        #else
+            check const& other
+        #endif
+    ) {
         #if !defined(BOOST_CONTRACT_NO_CONDITIONS) || \
                 defined(BOOST_CONTRACT_STATIC_LINK)
-            // Copy ctor moves cond_ pointer to dest.
-            : cond_(const_cast<check&>(other).cond_.release())
+            #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+                cond_.move(other.cond_);
+            #else // Emulate move (only way to return by value in C++03).
+                cond_.move(const_cast<check&>(other).cond_);
+            #endif
         #endif
-    {}
+    }
 
     /**
     Construct this object to check the specified contract.
@@ -326,7 +337,7 @@ public:
                 (This is declared @c noexcept(false) since C++11.)
     */
     ~check /** @cond */ BOOST_PREVENT_MACRO_SUBSTITUTION /** @endcond */ ()
-        BOOST_NOEXCEPT_IF(false) /* allow auto_ptr dtor to throw */
+        BOOST_NOEXCEPT_IF(false) /* allow cond_storage dtor to throw */
     {}
 
 /** @cond */
@@ -335,8 +346,7 @@ private:
 
     #if !defined(BOOST_CONTRACT_NO_CONDITIONS) || \
             defined(BOOST_CONTRACT_STATIC_LINK)
-        boost::contract::detail::auto_ptr<boost::contract::detail::cond_base>
-                cond_;
+        boost::contract::detail::cond_buffer cond_;
     #endif
 /** @endcond */
 };
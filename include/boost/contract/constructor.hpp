@@ -14,6 +14,7 @@ Program contracts for constructors.
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/core/specify.hpp>
 #include <boost/contract/core/access.hpp>
+#include <boost/contract/core/invariant_epoch.hpp>
 #include <boost/contract/core/constructor_precondition.hpp>
 #if     !defined(BOOST_CONTRACT_NO_CONSTRUCTORS) || \
         !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
@@ -95,8 +96,9 @@ specify_old_postcondition_except<> constructor(Class* obj) {
     #if     !defined(BOOST_CONTRACT_NO_CONSTRUCTORS) || \
             !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
              defined(BOOST_CONTRACT_STATIC_LINK)
-        return specify_old_postcondition_except<>(
-                new boost::contract::detail::constructor<Class>(obj));
+        specify_old_postcondition_except<> s;
+        s.own_.reset(new(s.own_) boost::contract::detail::constructor<Class>(obj));
+        return s;
     #else
         return specify_old_postcondition_except<>();
     #endif
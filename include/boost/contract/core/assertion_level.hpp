@@ -0,0 +1,141 @@
+
+#ifndef BOOST_CONTRACT_ASSERTION_LEVEL_HPP_
+#define BOOST_CONTRACT_ASSERTION_LEVEL_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Select assertion levels checked at run-time.
+*/
+
+// IMPORTANT: Included by assert.hpp and check_macro.hpp so trivial headers only
+// (plus atomic, to load level inline).
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/declspec.hpp> // No compile-time overhead.
+#include <boost/contract/detail/thread_policy.hpp>
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Assertion levels predefined by this library.
+
+Assertions programmed using @RefMacro{BOOST_CONTRACT_ASSERT_LEVEL} and
+@RefMacro{BOOST_CONTRACT_CHECK_LEVEL} can also use any other numeric level
+greater than these (e.g., <c>assertion_level_audit + 1</c> for assertions even
+more expensive than audit ones, but that can still be checked at run-time
+differently from axioms).
+
+@see @RefSect{extras.assertion_levels, Assertion Levels}
+*/
+enum assertion_level {
+    /**
+    Level of assertions programmed using @RefMacro{BOOST_CONTRACT_ASSERT} and
+    @RefMacro{BOOST_CONTRACT_CHECK} (this is the assertion level set by
+    default, it is also the lowest one so these assertions are always checked).
+    */
+    assertion_level_default = 0,
+
+    /**
+    Level of assertions programmed using
+    @RefMacro{BOOST_CONTRACT_ASSERT_AUDIT} and
+    @RefMacro{BOOST_CONTRACT_CHECK_AUDIT} (unless
+    @RefMacro{BOOST_CONTRACT_AUDITS} is defined, in which case these assertions
+    are always checked).
+    */
+    assertion_level_audit = 1
+};
+
+/** @cond */
+namespace assertion_level_ {
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    unsigned set(unsigned level) BOOST_NOEXCEPT_OR_NOTHROW;
+
+    #ifndef BOOST_CONTRACT_HEADER_ONLY
+        // Exported variable (not function) so get_assertion_level loads it
+        // inline (constant init, so no init order issue).
+        BOOST_CONTRACT_DETAIL_DECLSPEC
+        extern boost::atomic<unsigned> data;
+
+        inline boost::atomic<unsigned>& level() BOOST_NOEXCEPT_OR_NOTHROW {
+            return data;
+        }
+    #endif // Else, local static defined inline with set.
+}
+/** @endcond */
+
+} } // namespace
+
+/** @cond */
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/assertion_level.hpp>
+#endif
+/** @endcond */
+
+namespace boost { namespace contract {
+
+// Following must be inline for static linkage (no DYN_LINK and no HEADER_ONLY).
+
+/**
+Set the assertion level checked at run-time.
+
+Assertions programmed with a level greater than the one set by this function
+are not checked at run-time (but they are always compiled and validated
+syntactically).
+This level is shared by all threads (and by all user code linking to this
+library as a shared library) so it can be raised and lowered at run-time
+without recompiling code (for example, to check audit assertions only on
+some production hosts or only for some time).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param level    New assertion level to set (this is usually
+                @RefEnum{boost::contract::assertion_level} but it can be any
+                other numeric level).
+
+@return Same assertion level @p level passed as parameter.
+
+@see @RefSect{extras.assertion_levels, Assertion Levels}
+*/
+inline unsigned set_assertion_level(unsigned level)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    return assertion_level_::set(level);
+}
+
+/**
+Return the assertion level currently checked at run-time by the calling thread.
+
+This returns the level set by a @RefClass{boost::contract::scoped_policy}
+while one is in effect for the calling thread (instead of the level set by
+@RefFunc{boost::contract::set_assertion_level}).
+This is called internally by this library every time an assertion programmed
+with a level is about to be checked, and it is inlined: it reads a thread-local
+variable (for scoped policies) and then, unless a scoped policy set the level,
+it loads the atomic variable of this library holding the level (without any
+memory ordering constraint, and without calling into this library also when it
+is linked as a shared library).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@return Assertion level currently set
+        (@RefEnum{boost::contract::assertion_level} <c>assertion_level_default
+        </c> by default).
+
+@see @RefSect{extras.assertion_levels, Assertion Levels}
+*/
+inline unsigned get_assertion_level()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    boost::contract::detail::thread_policy const& p =
+            boost::contract::detail::thread_policy::ref();
+    return p.level_set ? p.level :
+            assertion_level_::level().load(boost::memory_order_relaxed);
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,101 @@
+
+#ifndef BOOST_CONTRACT_CHECK_DEPTH_HPP_
+#define BOOST_CONTRACT_CHECK_DEPTH_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Check contracts only at the outermost levels of nested contracted calls.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/declspec.hpp> // No compile-time overhead.
+#include <boost/config.hpp>
+
+namespace boost { namespace contract {
+
+/** @cond */
+namespace check_depth_ {
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    unsigned set(unsigned depth) BOOST_NOEXCEPT_OR_NOTHROW;
+
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    unsigned get() BOOST_NOEXCEPT_OR_NOTHROW;
+}
+/** @endcond */
+
+} } // namespace
+
+/** @cond */
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/core/check_depth.hpp>
+#endif
+/** @endcond */
+
+namespace boost { namespace contract {
+
+// Following must be inline for static linkage (no DYN_LINK and no HEADER_ONLY).
+
+/**
+Set the maximum nesting depth of contracted calls checked at run-time.
+
+Each thread counts the contracted calls it is executing (functions, public
+functions, constructors, and destructors with a contract declared using
+@RefClass{boost::contract::check}, including calls whose contracts are not
+checked).
+Contracts of calls nested deeper than the depth set by this function are not
+checked at all (as if they were sampled out by
+@RefClass{boost::contract::sample}), so deep recursive or layered code only
+checks contracts at its outermost levels.
+This is independent from (and in addition to) disabling assertions while
+checking other assertions.
+The depth set by this function has no effect unless
+@RefMacro{BOOST_CONTRACT_CHECK_DEPTH} is defined.
+
+This depth is shared by all threads (and by all user code linking to this
+library as a shared library) so it can be changed at run-time without
+recompiling code.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param depth    New maximum depth to set (@c 1 to check contracts only for the
+                outermost contracted calls, or @c 0 to check contracts at any
+                depth as by default).
+
+@return Same depth @p depth passed as parameter.
+
+@see @RefSect{advanced.depth_limited_checking, Depth-Limited Checking}
+*/
+inline unsigned set_check_depth(unsigned depth)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    return check_depth_::set(depth);
+}
+
+/**
+Return the maximum nesting depth of contracted calls checked at run-time.
+
+This is called internally by this library every time a contract is about to
+be checked when @RefMacro{BOOST_CONTRACT_CHECK_DEPTH} is defined, and it calls
+a function of this library that loads an atomic variable (without any memory
+ordering constraint, and inlined only if @RefMacro{BOOST_CONTRACT_HEADER_ONLY}
+is defined).
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@return Maximum depth currently set (@c 0 by default, meaning contracts are
+        checked at any depth).
+
+@see @RefSect{advanced.depth_limited_checking, Depth-Limited Checking}
+*/
+inline unsigned get_check_depth()
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    return check_depth_::get();
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -55,6 +55,52 @@ Macros for implementation checks.
     #define BOOST_CONTRACT_CHECK(cond) /* nothing */
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Assert implementation check conditions only when the assertion level set at
+    run-time is greater than or equal to the specified level.
+
+    The specified condition will always be compiled and validated
+    syntactically, but it will be evaluated at run-time only if @p level is less
+    than or equal to the value returned by
+    @RefFunc{boost::contract::get_assertion_level} when this check is reached
+    (see that function for the cost of this check).
+    This macro is defined by code equivalent to:
+
+    @code
+    #define BOOST_CONTRACT_CHECK_LEVEL(level, cond) \
+        if((level) <= boost::contract::get_assertion_level()) \
+            BOOST_CONTRACT_CHECK(cond); \
+        else \
+            BOOST_CONTRACT_CHECK(true || cond)
+    @endcode
+
+    @see @RefSect{extras.assertion_levels, Assertion Levels}
+
+    @param level    Assertion level (this is usually
+                    @RefEnum{boost::contract::assertion_level} but it can be any
+                    other numeric level).
+    @param cond Boolean condition to check within implementation code (function
+                body, etc.).
+                (This is not a variadic macro parameter so any comma it might
+                contain must be protected by round parenthesis,
+                @c BOOST_CONTRACT_CHECK_LEVEL(level, (cond)) will always
+                work.)
+    */
+    #define BOOST_CONTRACT_CHECK_LEVEL(level, cond)
+#elif !defined(BOOST_CONTRACT_NO_CHECKS)
+    #include <boost/contract/core/assertion_level.hpp>
+
+    #define BOOST_CONTRACT_CHECK_LEVEL(level, cond) \
+        { \
+            if((level) <= boost::contract::get_assertion_level()) \
+                BOOST_CONTRACT_CHECK(cond) \
+        }
+#else
+    #define BOOST_CONTRACT_CHECK_LEVEL(level, cond) \
+        BOOST_CONTRACT_DETAIL_NOEVAL(cond)
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Preferred way to assert implementation check conditions that are
@@ -63,7 +109,9 @@ Macros for implementation checks.
 
     The specified condition will always be compiled and validated
     syntactically, but it will not be evaluated at run-time unless
-    @RefMacro{BOOST_CONTRACT_AUDITS} is defined (undefined by default).
+    @RefMacro{BOOST_CONTRACT_AUDITS} is defined (undefined by default) or the
+    assertion level set at run-time is audit or greater (see
+    @RefFunc{boost::contract::set_assertion_level}).
     This macro is defined by code equivalent to:
 
     @code
@@ -72,7 +120,8 @@ Macros for implementation checks.
             BOOST_CONTRACT_CHECK(cond)
     #else
         #define BOOST_CONTRACT_CHECK_AUDIT(cond) \
-            BOOST_CONTRACT_CHECK(true || cond)
+            BOOST_CONTRACT_CHECK_LEVEL( \
+                    boost::contract::assertion_level_audit, cond)
     #endif
     @endcode
 
@@ -96,7 +145,7 @@ Macros for implementation checks.
         BOOST_CONTRACT_CHECK(cond)
 #else
     #define BOOST_CONTRACT_CHECK_AUDIT(cond) \
-        BOOST_CONTRACT_DETAIL_NOEVAL(cond)
+        BOOST_CONTRACT_CHECK_LEVEL(boost::contract::assertion_level_audit, cond)
 #endif
     
 /**
@@ -127,12 +127,15 @@ Configure this library compile-time and run-time behaviours.
     This library will automatically define this macro when Boost libraries are
     built without threads (e.g., defining @c BOOST_DISABLE_THREADS).
 
-    @note   When this macro is left undefined this library needs to internally
-            use some sort of global lock (to ensure contract checking is
-            globally disabled when other contracts are being checked and also to
-            safely access failure handler functors).
-            That could introduce an undesired amount of synchronization in some
-            multi-threaded applications.
+    @note   This library never locks internal data, not even when this macro
+            is left undefined.
+            Failure handler functors are atomically published as immutable
+            snapshots by the @c set_..._failure functions so concurrent
+            failures call their handlers in parallel (and a handler can itself
+            fail or set handlers without deadlocks).
+            Disabling assertion checking while other assertions are being
+            checked is tracked per thread (defining this macro only replaces
+            that thread-local state with a plain global variable).
     
     @see @RefSect{contract_programming_overview.assertions, Assertions}
     */
@@ -161,6 +164,95 @@ Configure this library compile-time and run-time behaviours.
     #define BOOST_CONTRACT_MAX_ARGS 10
 #endif
 
+#ifndef BOOST_CONTRACT_FUNCTOR_BUFFER_SIZE
+    /**
+    Size in bytes of the buffer used to hold each contract functor without heap
+    allocations (default to six pointers).
+
+    Functors passed to @c .precondition(...), @c .old(...),
+    @c .postcondition(...), and @c .except(...) (lambdas, binds, etc.) are
+    internally held in a buffer of this size (instead of using Boost.Function).
+    Functors that do not fit in this buffer (for example, lambdas that capture
+    many variables by value) are allocated on the heap instead, so users can
+    redefine this macro to a larger value to avoid heap allocations in those
+    cases.
+    The default size fits lambdas that capture up to six variables by reference.
+
+    @warning    This macro changes the layout of
+                @RefClass{boost::contract::check} so it must be defined to the
+                same value in all code linked together.
+    
+    @see @RefMacro{BOOST_CONTRACT_CHECK_BUFFER_SIZE}
+    */
+    #define BOOST_CONTRACT_FUNCTOR_BUFFER_SIZE (6 * sizeof(void*))
+#endif
+
+#ifndef BOOST_CONTRACT_OLD_COPIES
+    /**
+    Number of old value copies held without heap allocations when
+    subcontracting (default to @c 4).
+
+    Public function overrides pass the old values copied by overridden
+    functions in base classes (either at body or via @c .old(...)) using two
+    queues (one for old values copied at body and one for old values copied by
+    @c .old(...)).
+    These queues hold up to this number of old values each (as pointers to the
+    old value copies) in place, and only allocate on the heap to hold more old
+    values than that, so users can redefine this macro to a larger value to
+    avoid heap allocations when overridden functions copy many old values (or
+    to @c 0 to reduce stack usage).
+    Together with the public function override contract, these queues are held
+    in the buffer of @RefClass{boost::contract::check} when that is large
+    enough (see @RefMacro{BOOST_CONTRACT_CHECK_BUFFER_SIZE}).
+
+    @warning    This macro changes the layout of
+                @RefClass{boost::contract::virtual_} so it must be defined to
+                the same value in all code linked together.
+
+    @see    @RefSect{tutorial.public_function_overrides__subcontracting_,
+            Public Function Overrides}
+    */
+    #define BOOST_CONTRACT_OLD_COPIES 4
+#endif
+
+#ifndef BOOST_CONTRACT_CHECK_BUFFER_SIZE
+    /**
+    Size in bytes of the buffer used to hold contracts without heap allocations
+    (default to four functor buffers, plus four pointers for each old value
+    copy held in place by @RefMacro{BOOST_CONTRACT_OLD_COPIES}, plus
+    twenty-eight pointers, i.e., @c 608 on 64-bit platforms).
+
+    @RefClass{boost::contract::check} uses a buffer of this size to internally
+    hold the contract being checked, so each function call with a contract
+    takes about this many bytes of stack (plus a few pointers, i.e., about
+    @c 656 bytes on 64-bit platforms by default).
+    The object returned by @RefFunc{boost::contract::function},
+    @RefFunc{boost::contract::constructor},
+    @RefFunc{boost::contract::destructor}, or
+    @RefFunc{boost::contract::public_function} does not take this stack
+    space, it holds the contract in one of two per-thread buffers of this size
+    until it is assigned to a @RefClass{boost::contract::check} object.
+    Contracts that do not fit in this buffer are allocated on the heap instead
+    (for example, public function overrides with many arguments or functors
+    that capture many variables by value), so users can redefine this macro to
+    a larger value to avoid heap allocations in those cases, or to @c 0 to
+    always allocate contracts on the heap and reduce stack usage.
+    (The contracts of public function overrides also hold here the queues used
+    to pass old values to overridden functions, see
+    @RefMacro{BOOST_CONTRACT_OLD_COPIES}.)
+
+    @warning    This macro changes the layout of
+                @RefClass{boost::contract::check} so it must be defined to the
+                same value in all code linked together.
+
+    @see    @RefMacro{BOOST_CONTRACT_FUNCTOR_BUFFER_SIZE},
+            @RefMacro{BOOST_CONTRACT_OLD_COPIES}
+    */
+    #define BOOST_CONTRACT_CHECK_BUFFER_SIZE \
+        (4 * (BOOST_CONTRACT_FUNCTOR_BUFFER_SIZE + 2 * sizeof(void*)) + \
+                (4 * BOOST_CONTRACT_OLD_COPIES + 28) * sizeof(void*))
+#endif
+
 #ifndef BOOST_CONTRACT_BASES_TYPEDEF
     /**
     Define the name of the base type @c typedef (@c base_types by default).
@@ -293,6 +385,40 @@ Configure this library compile-time and run-time behaviours.
     #define BOOST_CONTRACT_PERMISSIVE
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Call each overridden function fewer times when subcontracting (undefined by
+    default).
+
+    By default, public function overrides call the overridden functions from
+    their base classes once for each check (to push old values at body, check
+    entry invariants, preconditions, old values, exit invariants, and then
+    postconditions or exception guarantees), and the related contract checks
+    are executed in that order across all bases.
+    If this macro is defined, each overridden function is instead called once
+    to push its old values at body and check its entry invariants, and once to
+    check its exit invariants together with its postconditions (or exception
+    guarantees).
+    That reduces the number of (virtual) calls made to subcontract, but base
+    exit invariants and postconditions (or exception guarantees) are then
+    checked one base at a time, and base old values at body are copied while
+    other assertions are disabled.
+    (Preconditions and @c .old(...) functors are still called in separate
+    passes over the bases, because preconditions are checked in logic-or among
+    bases and @c .old(...) functors must be called after all preconditions.)
+
+    This macro must be defined in the same way for all compilation units that
+    share contracted virtual functions (as for the other macros of this
+    library).
+
+    @see    @RefSect{contract_programming_overview.benefits_and_costs,
+            Benefits and Costs},
+            @RefSect{tutorial.public_function_overrides__subcontracting_,
+            Public Function Overrides}
+    */
+    #define BOOST_CONTRACT_SINGLE_PASS_SUBCONTRACTING
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     Code block to execute if contracts are not assigned to a
@@ -370,13 +496,147 @@ Configure this library compile-time and run-time behaviours.
     syntactically.
     However, they are not evaluated and checked at run-time unless
     this macro is defined (because these conditions can be computationally
-    expensive, at least compared to the cost of executing the function body).
+    expensive, at least compared to the cost of executing the function body),
+    or unless the assertion level is raised to audit at run-time using
+    @RefFunc{boost::contract::set_assertion_level}.
 
     @see @RefSect{extras.assertion_levels, Assertion Levels}
     */
     #define BOOST_CONTRACT_AUDITS
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro so each assertion can be enabled and disabled at run-time
+    by its source location (undefined by default).
+
+    If this macro is defined, each assertion programmed via
+    @RefMacro{BOOST_CONTRACT_ASSERT}, @RefMacro{BOOST_CONTRACT_CHECK}, etc.
+    declares a local static @RefClass{boost::contract::site} so the assertion
+    condition is not evaluated at run-time while that site is disabled (this
+    costs a single atomic load and a single branch per assertion, and it
+    requires C++11 lambdas).
+    
+    @see @RefSect{advanced.contract_sites, Contract Sites}
+    */
+    #define BOOST_CONTRACT_SITES
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro to count calls, checks, and failures, and to time the
+    checking phases of each contract and assertion site (undefined by default).
+
+    If this macro is defined, contracts declared right after
+    @RefClass{boost::contract::sample} constructed with a
+    @RefClass{boost::contract::site} record their metrics in per-thread
+    counters of that site (and so do assertions when
+    @RefMacro{BOOST_CONTRACT_SITES} is also defined).
+    Counters of all threads are merged by
+    @RefFunc{boost::contract::metrics::snapshot}.
+
+    @see @RefSect{advanced.contract_metrics, Contract Metrics}
+    */
+    #define BOOST_CONTRACT_METRICS
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro to emit static tracepoints when contracts are checked
+    (undefined by default).
+
+    If this macro is defined on Linux x86-64 and AArch64 using GCC or Clang,
+    this library emits SystemTap SDT probes (provider @c boost_contract, as
+    declared by <c>\<sys/sdt.h\></c> but without requiring that header) at
+    the initialization of each contract, at the beginning and end of each of
+    its checking phases, and at its failures.
+    Each probe compiles to a single no-op instruction that tools like
+    @c perf, @c bpftrace, and SystemTap can trace at run-time.
+    Otherwise, this macro has no effect.
+
+    @see @RefSect{advanced.static_probes, Static Probes}
+    */
+    #define BOOST_CONTRACT_PROBES
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro to record the checking phases of contracts as a timeline
+    (undefined by default).
+
+    If this macro is defined, each thread records the entry invariants,
+    preconditions, old values, body, exit invariants, postconditions or
+    exception guarantees, and subcontracted base calls of the contracts it
+    checks into its own buffer (without locks and without allocating memory
+    after the buffer is allocated), while a
+    @RefClass{boost::contract::trace::recorder} exists.
+    This requires C++11 @c chrono (otherwise, nothing is recorded).
+
+    @see @RefSect{advanced.contract_timelines, Contract Timelines}
+    */
+    #define BOOST_CONTRACT_TRACE
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro so contract checking phases notify an observer
+    (undefined by default).
+
+    If this macro is defined, the observer installed by
+    @RefFunc{boost::contract::set_observer} (if any) is notified at the end of
+    each checking phase of each contract with the site, phase, object, result,
+    and time of that phase.
+    While no observer is installed, this costs a single inlined atomic load
+    (with acquire memory ordering) and a single branch per checking phase (and
+    nothing if this macro is not defined).
+
+    @see @RefSect{advanced.contract_observers, Contract Observers}
+    */
+    #define BOOST_CONTRACT_OBSERVER
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro so contracts are checked only up to the nesting depth set
+    by @RefFunc{boost::contract::set_check_depth} (undefined by default).
+
+    If this macro is defined, each thread counts the contracted calls it is
+    executing, which costs an increment and a decrement of a thread-local
+    counter and a call that loads an atomic variable per contract.
+    Otherwise, contracts are checked at any depth and the depth set by
+    @RefFunc{boost::contract::set_check_depth} has no effect.
+
+    @see @RefSect{advanced.depth_limited_checking, Depth-Limited Checking}
+    */
+    #define BOOST_CONTRACT_CHECK_DEPTH
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Define this macro so sites are enabled and disabled at run-time by patching
+    code (undefined by default).
+
+    If this macro is defined, @RefMacro{BOOST_CONTRACT_SITE_ENABLED} (and
+    assertions when @RefMacro{BOOST_CONTRACT_SITES} is also defined) compile to
+    a single instruction, which is patched to a no-op while its site is
+    disabled and to a jump to the checking code while its site is enabled (in
+    the style of Linux kernel static keys).
+    So a disabled site costs no load and no branch, while enabling and
+    disabling sites becomes more expensive (code pages are made writable by
+    @c mprotect and written, so this requires the program to be allowed to
+    modify its own code, otherwise that instruction is left as compiled to jump
+    to the usual atomic load and branch).
+
+    This is supported on Linux x86-64 and AArch64 using GCC or Clang (using
+    @c asm @c goto), while this macro has no effect on all other platforms and
+    compilers (where checking sites costs an atomic load and a branch as
+    usual).
+    
+    @see @RefSect{advanced.contract_sites, Contract Sites}
+    */
+    #define BOOST_CONTRACT_STATIC_KEYS
+#endif
+
 #ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
     /**
     If defined, this library does not perform implementation checks (undefined
@@ -567,6 +827,29 @@ Configure this library compile-time and run-time behaviours.
     #define BOOST_CONTRACT_NO_INVARIANTS
 #endif
 
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    If defined, this library does not check class invariants of public
+    functions, constructors, and destructors called (directly or indirectly)
+    from within a public function, constructor, or destructor of the same object
+    (undefined by default).
+
+    This follows the Eiffel rule that class invariants are checked only by
+    qualified calls from outside the object: invariants of the outer call are
+    still checked at its entry and exit, while invariants of nested calls on the
+    same object are not checked (because the object might legitimately be in an
+    intermediate state while the outer call is executing its body).
+    The objects with calls in progress are kept on a small per-thread stack
+    (calls nested deeper than that stack check their invariants as usual).
+    This macro has no effect when @RefMacro{BOOST_CONTRACT_NO_INVARIANTS} is
+    defined.
+
+    @see    @RefSect{advanced.nested_calls_on_the_same_object,
+            Nested Calls on the Same Object}
+    */
+    #define BOOST_CONTRACT_NO_NESTED_INVARIANTS
+#endif
+
 #ifdef BOOST_CONTRACT_NO_OLDS
     #error "define NO_POSTCONDITIONS and NO_EXCEPTS instead"
 #elif   defined(BOOST_CONTRACT_NO_POSTCONDITIONS) && \
@@ -15,6 +15,7 @@ Handle contract assertion failures.
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/detail/declspec.hpp> // No compile-time overhead.
 #include <boost/function.hpp>
+#include <boost/atomic.hpp>
 #include <boost/config.hpp>
 #include <exception>
 #include <string>
@@ -156,6 +157,19 @@ public:
     @param code Text listing the source code of the assertion condition.
     */
     explicit assertion_failure(char const* code);
+
+    /**
+    Copy this object (its string is formatted again by @c what() if needed).
+    @param other    Object to copy.
+    */
+    assertion_failure(assertion_failure const& other);
+
+    /**
+    Assign this object (its string is formatted again by @c what() if needed).
+    @param other    Object to assign.
+    @return Reference to this object.
+    */
+    assertion_failure& operator=(assertion_failure const& other);
     
     /**
     Destruct this object.
@@ -170,6 +184,13 @@ public:
     
     @b Throws: This is declared @c noexcept (or @c throw() before C++11).
     
+    This string is formatted only when this function is first called (so
+    constructing and throwing this object never allocates memory), into a
+    fixed-size buffer held by this object (so long source code text or file
+    names might be truncated and terminated by @c "...").
+    This function can be called concurrently by multiple threads (e.g., for an
+    exception object rethrown to multiple threads via @c std::exception_ptr).
+
     @return A string formatted similarly to the following:
       <c>assertion "`code()`" failed: file "`file()`", line \`line()\`</c>.
             File, line, and code will be omitted from this string if they were
@@ -209,7 +230,10 @@ private:
     char const* file_;
     unsigned long line_;
     char const* code_;
-    std::string what_;
+    // Formatted by what() on first call, by only one thread (see formatting_).
+    mutable char what_[256];
+    enum formatting { unformatted, formatting_what, formatted };
+    mutable boost::atomic<unsigned char> formatting_;
 /** @endcond */
 };
 
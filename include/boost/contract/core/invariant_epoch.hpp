@@ -0,0 +1,132 @@
+
+#ifndef BOOST_CONTRACT_INVARIANT_EPOCH_HPP_
+#define BOOST_CONTRACT_INVARIANT_EPOCH_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Skip entry invariants of objects not changed since their last exit invariants.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/atomic.hpp>
+
+namespace boost { namespace contract {
+
+/** @cond */
+namespace detail {
+    template<typename VR, class C>
+    class cond_inv;
+}
+/** @endcond */
+
+/**
+Base class to skip checking entry invariants of objects that have not changed
+since their invariants were last checked at exit.
+
+User-defined classes can opt-in by inheriting from this class (publicly or
+privately, but only once per object so virtually when more than one base class
+inherits from it):
+
+@code
+class u : private boost::contract::invariant_epoch { // No base_types needed.
+    friend class boost::contract::access;
+
+    void invariant() const { ... }
+
+public:
+    ...
+};
+@endcode
+
+Then this library changes the epoch of the object at entry (after checking
+entry invariants) and exit (before checking exit invariants) of its non-const
+public functions and at exit of its constructors, and it records the epoch
+when exit invariants pass.
+Entry non-static invariants of a class are not checked if the object epoch has
+not changed since the exit invariants of the same class were last checked
+(const public functions never change the epoch, so a sequence of calls on the
+same object checks roughly half of the invariants).
+Static invariants, invariants of volatile public functions, and invariants of
+base classes checked for subcontracting when they differ from the class of the
+last exit check are always checked.
+
+This assumes the object is only changed by its non-const public functions (and
+constructors).
+If the object is changed otherwise (e.g., by friend functions, via references
+to its data members, or by const functions modifying @c mutable data members),
+programmers must call @RefMemberFunction{boost::contract::invariant_epoch,
+bump} after such changes.
+
+@see    @RefSect{advanced.invariant_epochs, Invariant Epochs}
+*/
+class invariant_epoch {
+public:
+    /** Construct this object (invariants not checked yet). */
+    invariant_epoch() : generation_(1), checked_(0), checked_class_(0) {}
+
+    /** Copy construct this object (invariants of the copy not checked yet). */
+    invariant_epoch(invariant_epoch const&) : generation_(1), checked_(0),
+            checked_class_(0) {}
+
+    /** Copy assign this object (this changes the epoch of the assigned one). */
+    invariant_epoch& operator=(invariant_epoch const&) {
+        bump();
+        return *this;
+    }
+
+    /**
+    Change the epoch of this object, so its next entry invariants are checked.
+
+    This must be called after changing the object other than via its non-const
+    public functions and constructors.
+    */
+    void bump() const {
+        generation_.store(generation_.load(boost::memory_order_relaxed) + 1,
+                boost::memory_order_relaxed);
+    }
+
+/** @cond */
+private:
+    // Address of one char per class (so never equal to checked_class_ 0).
+    template<class C>
+    struct class_id { static char const value; };
+
+    template<class C>
+    bool unchanged() const {
+        return checked_.load(boost::memory_order_relaxed) ==
+                    generation_.load(boost::memory_order_relaxed) &&
+                checked_class_.load(boost::memory_order_relaxed) ==
+                    &class_id<C>::value;
+    }
+
+    // Only const funcs can record concurrently, and then with same generation
+    // (so mixing their generation and class is still a valid record).
+    template<class C>
+    void checked() const {
+        checked_class_.store(&class_id<C>::value, boost::memory_order_relaxed);
+        checked_.store(generation_.load(boost::memory_order_relaxed),
+                boost::memory_order_relaxed);
+    }
+
+    mutable boost::atomic<unsigned long> generation_;
+    mutable boost::atomic<unsigned long> checked_;
+    mutable boost::atomic<char const*> checked_class_;
+
+    template<typename VR, class C>
+    friend class boost::contract::detail::cond_inv;
+/** @endcond */
+};
+
+/** @cond */
+template<class C>
+char const invariant_epoch::class_id<C>::value = 0;
+/** @endcond */
+
+} } // namespace
+
+#endif // #include guard
+
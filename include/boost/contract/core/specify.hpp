@@ -22,13 +22,9 @@ specified in that order.
         defined(BOOST_CONTRACT_STATIC_LINK)
     #include <boost/contract/detail/condition/cond_base.hpp>
     #include <boost/contract/detail/condition/cond_post.hpp>
-    #include <boost/contract/detail/auto_ptr.hpp>
-    #include <boost/contract/detail/none.hpp>
-#endif
-#if     !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
-        !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
-        !defined(BOOST_CONTRACT_NO_EXCEPTS)
+    #include <boost/contract/detail/condition/cond_storage.hpp>
     #include <boost/contract/detail/debug.hpp>
+    #include <boost/contract/detail/none.hpp>
 #endif
 #include <boost/config.hpp>
 
@@ -45,69 +41,104 @@ specified in that order.
 // error according with ON_MISSING_CHECK_DECL.
 #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) || \
         defined(BOOST_CONTRACT_STATIC_LINK)
+    #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+        #define BOOST_CONTRACT_SPECIFY_MOVE_PARAM_(class_type) class_type&&
+        #define BOOST_CONTRACT_SPECIFY_MOVE_ARG_(class_type, other) other
+    #else // Emulate move with const& (only way to return by value in C++03).
+        #define BOOST_CONTRACT_SPECIFY_MOVE_PARAM_(class_type) \
+            class_type const&
+        #define BOOST_CONTRACT_SPECIFY_MOVE_ARG_(class_type, other) \
+            const_cast<class_type&>(other)
+    #endif
+
+    // Contract object is constructed in place in storage owned by first object
+    // of the chain (returned by function, etc.), other objects refer to it.
     #define BOOST_CONTRACT_SPECIFY_CLASS_IMPL_(class_type, cond_type) \
         private: \
-            boost::contract::detail::auto_ptr<cond_type > cond_; \
-            explicit class_type(cond_type* cond) : cond_(cond) {} \
-            class_type(class_type const& other) : cond_(other.cond_) {} \
-            class_type& operator=(class_type const& other) { \
-                cond_ = other.cond_; \
-                return *this; \
+            boost::contract::detail::cond_storage* storage_; \
+            explicit class_type(boost::contract::detail::cond_storage* \
+                    storage) : storage_(storage) {} \
+            class_type(BOOST_CONTRACT_SPECIFY_MOVE_PARAM_(class_type) other) : \
+                    storage_(other.storage_) {} \
+            class_type& operator=(class_type const&); \
+            cond_type* cond() { \
+                BOOST_CONTRACT_DETAIL_DEBUG(storage_->get()); \
+                return static_cast<cond_type*>(storage_->get()); \
             }
     
-    #define BOOST_CONTRACT_SPECIFY_COND_RELEASE_ cond_.release()
+    // For specify_... objects that can be first in the chain (so own storage).
+    #define BOOST_CONTRACT_SPECIFY_OWNER_CLASS_IMPL_(class_type, cond_type) \
+        private: \
+            boost::contract::detail::cond_storage own_; \
+            boost::contract::detail::cond_storage* storage_; \
+            class_type() : storage_(&own_) {} \
+            explicit class_type(boost::contract::detail::cond_storage* \
+                    storage) : storage_(storage) {} \
+            class_type(BOOST_CONTRACT_SPECIFY_MOVE_PARAM_(class_type) other) : \
+                storage_(other.storage_ == &other.own_ ? &own_ : \
+                        other.storage_) \
+            { /* move contract object (no-op if other does not own it) */ \
+                own_.move(BOOST_CONTRACT_SPECIFY_MOVE_ARG_(class_type, \
+                        other).own_); \
+            } \
+            class_type& operator=(class_type const&); \
+            cond_type* cond() { \
+                BOOST_CONTRACT_DETAIL_DEBUG(storage_->get()); \
+                return static_cast<cond_type*>(storage_->get()); \
+            }
+    
+    #define BOOST_CONTRACT_SPECIFY_STORAGE_ storage_
 #else
     #define BOOST_CONTRACT_SPECIFY_CLASS_IMPL_(class_type, cond_type) \
         private: \
             class_type() {} \
             class_type(class_type const&) {} \
             class_type& operator=(class_type const&) { return *this; }
+    
+    #define BOOST_CONTRACT_SPECIFY_OWNER_CLASS_IMPL_(class_type, cond_type) \
+        BOOST_CONTRACT_SPECIFY_CLASS_IMPL_(class_type, cond_type)
 
-    #define BOOST_CONTRACT_SPECIFY_COND_RELEASE_ /* nothing */
+    #define BOOST_CONTRACT_SPECIFY_STORAGE_ /* nothing */
 #endif
 
 #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
     #define BOOST_CONTRACT_SPECIFY_PRECONDITION_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_pre(f); \
+        cond()->set_pre(f); \
         return specify_old_postcondition_except<VirtualResult>( \
-                BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+                BOOST_CONTRACT_SPECIFY_STORAGE_);
 #else
     #define BOOST_CONTRACT_SPECIFY_PRECONDITION_IMPL_ \
         return specify_old_postcondition_except<VirtualResult>( \
-                BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+                BOOST_CONTRACT_SPECIFY_STORAGE_);
 #endif
         
 #ifndef BOOST_CONTRACT_NO_OLDS
     #define BOOST_CONTRACT_SPECIFY_OLD_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_old(f); \
+        cond()->set_old(f); \
         return specify_postcondition_except<VirtualResult>( \
-                BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+                BOOST_CONTRACT_SPECIFY_STORAGE_);
 #else
     #define BOOST_CONTRACT_SPECIFY_OLD_IMPL_ \
         return specify_postcondition_except<VirtualResult>( \
-                BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+                BOOST_CONTRACT_SPECIFY_STORAGE_);
 #endif
             
 #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
     #define BOOST_CONTRACT_SPECIFY_POSTCONDITION_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_post(f); \
-        return specify_except(BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+        cond()->set_post(f); \
+        return specify_except(BOOST_CONTRACT_SPECIFY_STORAGE_);
 #else
     #define BOOST_CONTRACT_SPECIFY_POSTCONDITION_IMPL_ \
-        return specify_except(BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+        return specify_except(BOOST_CONTRACT_SPECIFY_STORAGE_);
 #endif
         
 #ifndef BOOST_CONTRACT_NO_EXCEPTS
     #define BOOST_CONTRACT_SPECIFY_EXCEPT_IMPL_ \
-        BOOST_CONTRACT_DETAIL_DEBUG(cond_); \
-        cond_->set_except(f); \
-        return specify_nothing(BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+        cond()->set_except(f); \
+        return specify_nothing(BOOST_CONTRACT_SPECIFY_STORAGE_);
 #else
     #define BOOST_CONTRACT_SPECIFY_EXCEPT_IMPL_ \
-        return specify_nothing(BOOST_CONTRACT_SPECIFY_COND_RELEASE_);
+        return specify_nothing(BOOST_CONTRACT_SPECIFY_STORAGE_);
 #endif
 
 /* @endcond */
@@ -454,7 +485,7 @@ public:
 
 /** @cond */
 private:
-    BOOST_CONTRACT_SPECIFY_CLASS_IMPL_(
+    BOOST_CONTRACT_SPECIFY_OWNER_CLASS_IMPL_(
         specify_old_postcondition_except,
         boost::contract::detail::cond_post<typename
                 boost::contract::detail::none_if_void<VirtualResult>::type>
@@ -614,7 +645,7 @@ public:
 
 /** @cond */
 private:
-    BOOST_CONTRACT_SPECIFY_CLASS_IMPL_(
+    BOOST_CONTRACT_SPECIFY_OWNER_CLASS_IMPL_(
         specify_precondition_old_postcondition_except,
         boost::contract::detail::cond_post<typename
                 boost::contract::detail::none_if_void<VirtualResult>::type>
@@ -0,0 +1,398 @@
+
+#ifndef BOOST_CONTRACT_TYPED_SPECIFY_HPP_
+#define BOOST_CONTRACT_TYPED_SPECIFY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Specify preconditions, old value copies at body, postconditions, and exception
+guarantees with statically typed contracts (no
+@RefClass{boost::contract::check}).
+
+These are the statically typed counterparts of the classes in
+@c boost/contract/core/specify.hpp (see
+@RefFunc{boost::contract::typed_function}).
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/condition/cond_typed.hpp>
+#include <boost/contract/detail/none.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/config.hpp>
+
+/* PRIVATE */
+
+/* @cond */
+
+// Warn (since C++17) if the chain result is discarded instead of being held by
+// a local `auto c = ...` variable (exit checks would be run too early then).
+#ifdef BOOST_ATTRIBUTE_NODISCARD
+    #define BOOST_CONTRACT_TYPED_SPECIFY_NODISCARD_ BOOST_ATTRIBUTE_NODISCARD
+#else
+    #define BOOST_CONTRACT_TYPED_SPECIFY_NODISCARD_ /* nothing */
+#endif
+
+/* @endcond */
+
+/* CODE */
+
+namespace boost { namespace contract {
+    class typed_specify_precondition_old_postcondition_except;
+
+    typed_specify_precondition_old_postcondition_except typed_function();
+} }
+
+namespace boost { namespace contract {
+
+/**
+Used to prevent setting other contract conditions after exception guarantees
+(statically typed).
+
+This object checks postconditions or exception guarantees (as specified via
+@p Post and @p Except) when it goes out of scope at function exit.
+This object is internally constructed by this library when users specify
+contracts calling @RefFunc{boost::contract::typed_function} (that is why this
+class does not have a public constructor).
+
+@see @RefSect{advanced.statically_typed_contracts, Statically Typed Contracts}
+
+@tparam Post    Type of the postcondition functor (or internal @c none type).
+@tparam Except  Type of the exception guarantee functor (or internal @c none
+                type).
+*/
+template<typename Post, typename Except>
+class BOOST_CONTRACT_TYPED_SPECIFY_NODISCARD_ typed_specify_nothing {
+    // No set member function here.
+
+/** @cond */
+    BOOST_MOVABLE_BUT_NOT_COPYABLE(typed_specify_nothing)
+
+public:
+    // Move only (only last object in the chain checks on exit).
+    typed_specify_nothing(BOOST_RV_REF(typed_specify_nothing) other) :
+            cond_(boost::move(other.cond_)) {}
+
+private:
+    explicit typed_specify_nothing(BOOST_RV_REF_2_TEMPL_ARGS(boost::contract::
+            detail::cond_typed, Post, Except) cond) : cond_(boost::move(cond))
+    {}
+
+    explicit typed_specify_nothing(BOOST_RV_REF_2_TEMPL_ARGS(boost::contract::
+            detail::cond_typed, Post, boost::contract::detail::none) post,
+            Except const& except) :
+        cond_(boost::move(post), except)
+    {}
+
+    boost::contract::detail::cond_typed<Post, Except> cond_;
+
+    // Friends (used to limit library's public API).
+
+    friend class typed_specify_postcondition_except;
+
+    template<typename P>
+    friend class typed_specify_except;
+/** @endcond */
+};
+
+/**
+Allow to specify exception guarantees (statically typed).
+
+This object checks postconditions (as specified via @p Post) when it goes out
+of scope at function exit.
+This object is internally constructed by this library when users specify
+contracts calling @RefFunc{boost::contract::typed_function} (that is why this
+class does not have a public constructor).
+
+@see @RefSect{advanced.statically_typed_contracts, Statically Typed Contracts}
+
+@tparam Post    Type of the postcondition functor (or internal @c none type).
+*/
+template<typename Post>
+class BOOST_CONTRACT_TYPED_SPECIFY_NODISCARD_ typed_specify_except {
+public:
+    /**
+    Allow to specify exception guarantees.
+
+    @param f    Nullary functor called by this library to check exception
+                guarantees @c f() (see
+                @RefClass{boost::contract::specify_except}).
+
+    @return After exception guarantees have been specified, the object returned
+            by this function does not allow to specify any additional contract.
+    */
+    template<typename F>
+    typed_specify_nothing<Post, typename boost::contract::detail::
+            cond_typed_except<F>::type>
+    except(F const& f) {
+        return typed_specify_nothing<Post, typename boost::contract::detail::
+                cond_typed_except<F>::type>(boost::move(cond_),
+                boost::contract::detail::cond_typed_except<F>::value(f));
+    }
+
+/** @cond */
+    BOOST_MOVABLE_BUT_NOT_COPYABLE(typed_specify_except)
+
+public:
+    // Move only (only last object in the chain checks on exit).
+    typed_specify_except(BOOST_RV_REF(typed_specify_except) other) :
+            cond_(boost::move(other.cond_)) {}
+
+private:
+    explicit typed_specify_except(BOOST_RV_REF_2_TEMPL_ARGS(boost::contract::
+            detail::cond_typed, Post, boost::contract::detail::none) cond) :
+        cond_(boost::move(cond))
+    {}
+
+    boost::contract::detail::cond_typed<Post, boost::contract::detail::none>
+            cond_;
+
+    // Friends (used to limit library's public API).
+
+    friend class typed_specify_postcondition_except;
+/** @endcond */
+};
+
+/**
+Allow to specify postconditions or exception guarantees (statically typed).
+
+This object is internally constructed by this library when users specify
+contracts calling @RefFunc{boost::contract::typed_function} (that is why this
+class does not have a public constructor).
+
+@see @RefSect{advanced.statically_typed_contracts, Statically Typed Contracts}
+*/
+class typed_specify_postcondition_except {
+public:
+    /**
+    Allow to specify postconditions.
+
+    @param f    Nullary functor called by this library to check postconditions
+                @c f() (see
+                @RefClass{boost::contract::specify_postcondition_except}).
+
+    @return After postconditions have been specified, the object returned by
+            this function allows to optionally specify exception guarantees.
+    */
+    template<typename F>
+    typed_specify_except<typename boost::contract::detail::
+            cond_typed_post<F>::type>
+    postcondition(F const& f) {
+        typedef typename boost::contract::detail::cond_typed_post<F>::type
+                post_type;
+        return typed_specify_except<post_type>(boost::contract::detail::
+                cond_typed<post_type, boost::contract::detail::none>(entry_,
+                boost::contract::detail::cond_typed_post<F>::value(f),
+                boost::contract::detail::none()));
+    }
+
+    /**
+    Allow to specify exception guarantees.
+
+    @param f    Nullary functor called by this library to check exception
+                guarantees @c f() (see
+                @RefClass{boost::contract::specify_except}).
+
+    @return After exception guarantees have been specified, the object returned
+            by this function does not allow to specify any additional contract.
+    */
+    template<typename F>
+    typed_specify_nothing<boost::contract::detail::none, typename boost::
+            contract::detail::cond_typed_except<F>::type>
+    except(F const& f) {
+        typedef typename boost::contract::detail::cond_typed_except<F>::type
+                except_type;
+        return typed_specify_nothing<boost::contract::detail::none,
+                except_type>(boost::contract::detail::cond_typed<boost::
+                contract::detail::none, except_type>(entry_,
+                boost::contract::detail::none(),
+                boost::contract::detail::cond_typed_except<F>::value(f)));
+    }
+
+/** @cond */
+private:
+    explicit typed_specify_postcondition_except(boost::contract::detail::
+            cond_typed_entry const& entry) : entry_(entry) {}
+
+    boost::contract::detail::cond_typed_entry entry_;
+
+    // Friends (used to limit library's public API).
+
+    friend class typed_specify_precondition_old_postcondition_except;
+    friend class typed_specify_old_postcondition_except;
+/** @endcond */
+};
+
+/**
+Allow to specify old value copies at body, postconditions, and exception
+guarantees (statically typed).
+
+This object is internally constructed by this library when users specify
+contracts calling @RefFunc{boost::contract::typed_function} (that is why this
+class does not have a public constructor).
+
+@see @RefSect{advanced.statically_typed_contracts, Statically Typed Contracts}
+*/
+class typed_specify_old_postcondition_except {
+public:
+    /**
+    Allow to specify old value copies at body.
+
+    The functor is called right away (after preconditions) to copy old values.
+
+    @param f    Nullary functor called by this library @c f() to assign old
+                value copies just before the body is executed (see
+                @RefClass{boost::contract::specify_old_postcondition_except}).
+
+    @return After old value copies at body have been specified, the object
+            returned by this function allows to optionally specify
+            postconditions and exception guarantees.
+    */
+    template<typename F>
+    typed_specify_postcondition_except old(F const& f) {
+        entry_.copy_old(f);
+        return typed_specify_postcondition_except(entry_);
+    }
+
+    /**
+    Allow to specify postconditions.
+
+    @param f    Nullary functor called by this library to check postconditions
+                @c f().
+
+    @return After postconditions have been specified, the object returned by
+            this function allows to optionally specify exception guarantees.
+    */
+    template<typename F>
+    typed_specify_except<typename boost::contract::detail::
+            cond_typed_post<F>::type>
+    postcondition(F const& f) {
+        return typed_specify_postcondition_except(entry_).postcondition(f);
+    }
+
+    /**
+    Allow to specify exception guarantees.
+
+    @param f    Nullary functor called by this library to check exception
+                guarantees @c f().
+
+    @return After exception guarantees have been specified, the object returned
+            by this function does not allow to specify any additional contract.
+    */
+    template<typename F>
+    typed_specify_nothing<boost::contract::detail::none, typename boost::
+            contract::detail::cond_typed_except<F>::type>
+    except(F const& f) {
+        return typed_specify_postcondition_except(entry_).except(f);
+    }
+
+/** @cond */
+private:
+    explicit typed_specify_old_postcondition_except(boost::contract::detail::
+            cond_typed_entry const& entry) : entry_(entry) {}
+
+    boost::contract::detail::cond_typed_entry entry_;
+
+    // Friends (used to limit library's public API).
+
+    friend class typed_specify_precondition_old_postcondition_except;
+/** @endcond */
+};
+
+/**
+Allow to specify preconditions, old value copies at body, postconditions, and
+exception guarantees (statically typed).
+
+This object is internally constructed by this library when users specify
+contracts calling @RefFunc{boost::contract::typed_function} (that is why this
+class does not have a public constructor).
+
+@see @RefSect{advanced.statically_typed_contracts, Statically Typed Contracts}
+*/
+class typed_specify_precondition_old_postcondition_except {
+public:
+    /**
+    Allow to specify preconditions.
+
+    The functor is called right away to check preconditions.
+
+    @param f    Nullary functor called by this library to check preconditions
+                @c f() (see
+                @RefClass{boost::contract::specify_precondition_old_postcondition_except}).
+
+    @return After preconditions have been specified, the object returned by
+            this function allows to optionally specify old value copies at body,
+            postconditions, and exception guarantees.
+    */
+    template<typename F>
+    typed_specify_old_postcondition_except precondition(F const& f) {
+        entry_.check_pre(f);
+        return typed_specify_old_postcondition_except(entry_);
+    }
+
+    /**
+    Allow to specify old value copies at body.
+
+    @param f    Nullary functor called by this library @c f() to assign old
+                value copies just before the body is executed.
+
+    @return After old value copies at body have been specified, the object
+            returned by this function allows to optionally specify
+            postconditions and exception guarantees.
+    */
+    template<typename F>
+    typed_specify_postcondition_except old(F const& f) {
+        return typed_specify_old_postcondition_except(entry_).old(f);
+    }
+
+    /**
+    Allow to specify postconditions.
+
+    @param f    Nullary functor called by this library to check postconditions
+                @c f().
+
+    @return After postconditions have been specified, the object returned by
+            this function allows to optionally specify exception guarantees.
+    */
+    template<typename F>
+    typed_specify_except<typename boost::contract::detail::
+            cond_typed_post<F>::type>
+    postcondition(F const& f) {
+        return typed_specify_postcondition_except(entry_).postcondition(f);
+    }
+
+    /**
+    Allow to specify exception guarantees.
+
+    @param f    Nullary functor called by this library to check exception
+                guarantees @c f().
+
+    @return After exception guarantees have been specified, the object returned
+            by this function does not allow to specify any additional contract.
+    */
+    template<typename F>
+    typed_specify_nothing<boost::contract::detail::none, typename boost::
+            contract::detail::cond_typed_except<F>::type>
+    except(F const& f) {
+        return typed_specify_postcondition_except(entry_).except(f);
+    }
+
+/** @cond */
+private:
+    typed_specify_precondition_old_postcondition_except() {}
+
+    boost::contract::detail::cond_typed_entry entry_;
+
+    // Friends (used to limit library's public API).
+
+    friend typed_specify_precondition_old_postcondition_except typed_function();
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // #include guard
+
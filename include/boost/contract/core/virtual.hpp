@@ -16,12 +16,9 @@ Handle virtual public functions with contracts (for subcontracting).
 #ifndef BOOST_CONTRACT_NO_CONDITIONS
     #include <boost/contract/detail/decl.hpp>
 #endif
-#ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
-    #include <boost/any.hpp>
-#endif
 #ifndef BOOST_CONTRACT_NO_OLDS
+    #include <boost/contract/detail/inline_queue.hpp>
     #include <boost/shared_ptr.hpp>
-    #include <queue>
 #endif
 
 namespace boost { namespace contract {
@@ -121,9 +118,17 @@ private: // No public API (so users cannot use it directly by mistake).
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         explicit virtual_(action_enum a) :
               action_(a)
+            , actions_(0)
             , failed_(false)
+            , base_checked_(false)
+            , base_ftors_(0)
+            #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                    defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+                , nested_(false)
+            #endif
             #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
-                , result_type_name_()
+                , result_ptr_()
+                , result_type_()
                 , result_optional_()
             #endif
         {}
@@ -131,15 +136,32 @@ private: // No public API (so users cannot use it directly by mistake).
 
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         action_enum action_;
+        // Actions still to be executed by the base call (bit set, 1 << a).
+        unsigned short actions_;
         bool failed_;
+        // Returned by base calls to overriding functions (no exceptions used
+        // for that, base calls only throw to skip base function bodies).
+        bool base_checked_;
+        unsigned char base_ftors_;
+    #endif
+    #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+            defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+        // Overriding call nested in another call on same object (so base calls
+        // skip inv as well).
+        bool nested_;
     #endif
     #ifndef BOOST_CONTRACT_NO_OLDS
-        std::queue<boost::shared_ptr<void> > old_init_copies_;
-        std::queue<boost::shared_ptr<void> > old_ftor_copies_;
+        // Up to BOOST_CONTRACT_OLD_COPIES held in place (then on heap).
+        typedef boost::contract::detail::inline_queue<boost::shared_ptr<void>,
+                BOOST_CONTRACT_OLD_COPIES> old_copies_type;
+        old_copies_type old_init_copies_;
+        old_copies_type old_ftor_copies_;
     #endif
     #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
-        boost::any result_ptr_; // Result for virtual and overriding functions.
-        char const* result_type_name_;
+        // Result of overriding function, as typed pointer (type tag is address
+        // of static result type info, so no boost::any and no heap here).
+        void const* result_ptr_;
+        void const* result_type_;
         bool result_optional_;
     #endif
 
@@ -94,8 +94,9 @@ specify_old_postcondition_except<> destructor(Class* obj) {
     #if     !defined(BOOST_CONTRACT_NO_DESTRUCTORS) || \
             !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
              defined(BOOST_CONTRACT_STATIC_LINK)
-        return specify_old_postcondition_except<>(
-                new boost::contract::detail::destructor<Class>(obj));
+        specify_old_postcondition_except<> s;
+        s.own_.reset(new(s.own_) boost::contract::detail::destructor<Class>(obj));
+        return s;
     #else
         return specify_old_postcondition_except<>();
     #endif
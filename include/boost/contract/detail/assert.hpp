@@ -7,22 +7,81 @@
 // file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
 // See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
 
+#include <boost/contract/core/config.hpp>
 #include <boost/contract/core/exception.hpp>
+#ifdef BOOST_CONTRACT_SITES
+    #include <boost/config.hpp>
+    #ifdef BOOST_NO_CXX11_LAMBDAS
+        #error "BOOST_CONTRACT_SITES requires C++11 lambdas"
+    #endif
+    #include <boost/contract/site.hpp>
+    #include <boost/current_function.hpp>
+    #ifdef BOOST_CONTRACT_METRICS
+        #include <boost/contract/detail/metrics.hpp>
+    #endif
+#endif
 #include <boost/contract/detail/noop.hpp>
 #include <boost/preprocessor/stringize.hpp>
 
+#ifdef BOOST_CONTRACT_SITES
+    // Function of enclosing code passed to lambda (BOOST_CURRENT_FUNCTION in
+    // lambda would be lambda's), still constant init (no init guard).
+    #define BOOST_CONTRACT_DETAIL_ASSERT_SITE_ \
+        static boost::contract::site boost_contract_detail_site(__FILE__, \
+                __LINE__, 0)
+#endif
+
 // In detail because used by both ASSERT and CHECK.
 // Use ternary operator `?:` and no trailing `;` here to allow `if(...) ASSERT(
 // ...); else ...` (won't compile if expands using an if statement instead even
 // if wrapped by {}, and else won't compile if expands trailing `;`).
-#define BOOST_CONTRACT_DETAIL_ASSERT(cond) \
-    /* no if-statement here */ \
-    ((cond) ? \
-        BOOST_CONTRACT_DETAIL_NOOP \
-    : \
-        throw boost::contract::assertion_failure( \
-                __FILE__, __LINE__, BOOST_PP_STRINGIZE(cond)) \
-    ) /* no ; here */
+#ifndef BOOST_CONTRACT_SITES
+    #define BOOST_CONTRACT_DETAIL_ASSERT(cond) \
+        /* no if-statement here */ \
+        ((cond) ? \
+            BOOST_CONTRACT_DETAIL_NOOP \
+        : \
+            throw boost::contract::assertion_failure( \
+                    __FILE__, __LINE__, BOOST_PP_STRINGIZE(cond)) \
+        ) /* no ; here */
+#elif defined(BOOST_CONTRACT_METRICS)
+    // Same as below, also counting site checks and failures (site block passed
+    // to scope temporary, as lambda's static site not accessible after it).
+    #define BOOST_CONTRACT_DETAIL_ASSERT(cond) \
+        /* no if-statement here */ \
+        ((!boost::contract::detail::metrics_assertion_scope([] ( \
+            char const* function \
+        ) -> boost::contract::detail::metrics_assertion_site { \
+            BOOST_CONTRACT_DETAIL_ASSERT_SITE_; \
+            return boost::contract::detail::metrics_assertion( \
+                boost_contract_detail_site, \
+                BOOST_CONTRACT_DETAIL_SITE_ENABLED_IN( \
+                        boost_contract_detail_site, function) \
+            ); \
+        }(BOOST_CURRENT_FUNCTION)).enabled() || (cond)) ? \
+            BOOST_CONTRACT_DETAIL_NOOP \
+        : \
+            throw boost::contract::detail::metrics_assertion_failed( \
+                boost::contract::assertion_failure( \
+                        __FILE__, __LINE__, BOOST_PP_STRINGIZE(cond)) \
+            ) \
+        ) /* no ; here */
+#else
+    // Lambda to declare a static site within an expression (cond not evaluated
+    // if site disabled).
+    #define BOOST_CONTRACT_DETAIL_ASSERT(cond) \
+        /* no if-statement here */ \
+        ((![] (char const* function) -> bool { \
+            BOOST_CONTRACT_DETAIL_ASSERT_SITE_; \
+            return BOOST_CONTRACT_DETAIL_SITE_ENABLED_IN( \
+                    boost_contract_detail_site, function); \
+        }(BOOST_CURRENT_FUNCTION) || (cond)) ? \
+            BOOST_CONTRACT_DETAIL_NOOP \
+        : \
+            throw boost::contract::assertion_failure( \
+                    __FILE__, __LINE__, BOOST_PP_STRINGIZE(cond)) \
+        ) /* no ; here */
+#endif
 
 #endif // #include guard
 
@@ -0,0 +1,41 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_CALL_DEPTH_HPP_
+#define BOOST_CONTRACT_DETAIL_CALL_DEPTH_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/check_depth.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Per-thread nesting depth of contracted calls (see set_check_depth).
+// NOTE: Separate from checking (which counts nested checks, not calls).
+class call_depth {
+public:
+    // Return true if call too deep for its contract to be checked.
+    static bool enter() {
+        unsigned const d = ++depth::ref();
+        unsigned const max = boost::contract::get_check_depth();
+        return max != 0 && d > max;
+    }
+
+    static void exit() { --depth::ref(); }
+
+private:
+    struct depth_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var_init<depth_tag, unsigned, unsigned, 0> depth;
+    #else
+        typedef static_local_var_init<depth_tag, unsigned, unsigned, 0> depth;
+    #endif
+};
+
+} } } // namespace
+
+#endif // #include guard
+
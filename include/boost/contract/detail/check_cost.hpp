@@ -0,0 +1,134 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_CHECK_COST_HPP_
+#define BOOST_CONTRACT_DETAIL_CHECK_COST_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+
+/* PUBLIC */
+
+// Ticks are CPU time-stamp counter cycles where that is a single instruction,
+// steady clock counts otherwise (either way, only compared with other ticks).
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define BOOST_CONTRACT_DETAIL_CHECK_COST_TICKS
+#elif !defined(BOOST_NO_CXX11_HDR_CHRONO)
+    #include <chrono>
+    #define BOOST_CONTRACT_DETAIL_CHECK_COST_TICKS
+    #define BOOST_CONTRACT_DETAIL_CHECK_COST_CHRONO_
+#endif
+
+/* PRIVATE */
+
+#define BOOST_CONTRACT_DETAIL_CHECK_THREADS_TOTALS_ 4
+
+/* CODE */
+
+namespace boost { namespace contract { namespace detail {
+
+// Zero if no clock (then no check_cost is ever handed off, see next_contract).
+inline boost::uint64_t tick_count() {
+    #if defined(BOOST_CONTRACT_DETAIL_CHECK_COST_CHRONO_)
+        return static_cast<boost::uint64_t>(std::chrono::steady_clock::now().
+                time_since_epoch().count());
+    #elif defined(BOOST_CONTRACT_DETAIL_CHECK_COST_TICKS)
+        return __builtin_ia32_rdtsc();
+    #else
+        return 0;
+    #endif
+}
+
+// Ticks spent checking contracts of one site (and of all sites sharing the same
+// total, see boost::contract::budget_sampling).
+class check_cost : // Non-copyable (atomic counters).
+    private boost::noncopyable
+{
+public:
+    explicit check_cost(boost::atomic<boost::uint64_t>* total = 0) :
+            total_(total), ticks_(0), checks_(0) {}
+
+    void add(boost::uint64_t ticks) {
+        ticks_.fetch_add(ticks, boost::memory_order_relaxed);
+        if(total_) total_->fetch_add(ticks, boost::memory_order_relaxed);
+    }
+
+    void count() { checks_.fetch_add(1, boost::memory_order_relaxed); }
+
+    boost::uint64_t ticks() const {
+        return ticks_.load(boost::memory_order_relaxed);
+    }
+
+    unsigned long checks() const {
+        return checks_.load(boost::memory_order_relaxed);
+    }
+
+private:
+    boost::atomic<boost::uint64_t>* const total_;
+    boost::atomic<boost::uint64_t> ticks_;
+    boost::atomic<unsigned long> checks_;
+};
+
+// RAII to add ticks spent in scope to cost (clock not even read if null cost).
+class metering : // Non-copyable (RAII).
+    private boost::noncopyable
+{
+public:
+    explicit metering(check_cost* cost) : cost_(cost),
+            start_(cost ? tick_count() : 0) {}
+
+    ~metering() { if(cost_) cost_->add(tick_count() - start_); }
+
+private:
+    check_cost* const cost_;
+    boost::uint64_t const start_;
+};
+
+// Windows of the totals (i.e., budgets) this thread checked contracts for, so
+// each total counts the threads sharing its window. A thread alternating among
+// more totals than remembered here is counted more than once (underestimating
+// the overhead per thread).
+class check_threads {
+public:
+    // True if this thread is first counted for the window of this total.
+    static bool first(void const* total, unsigned long window) {
+        windows& w = windows_var::ref();
+        for(int i = 0; i < BOOST_CONTRACT_DETAIL_CHECK_THREADS_TOTALS_; ++i) {
+            if(w.totals[i] == total) {
+                if(w.windows[i] == window) return false;
+                w.windows[i] = window;
+                return true;
+            }
+        }
+        w.totals[w.last] = total; // Replace the least recently added.
+        w.windows[w.last] = window;
+        w.last = (w.last + 1) % BOOST_CONTRACT_DETAIL_CHECK_THREADS_TOTALS_;
+        return true;
+    }
+
+private:
+    struct windows { // POD (for pre-C++11 thread-local).
+        void const* totals[BOOST_CONTRACT_DETAIL_CHECK_THREADS_TOTALS_];
+        unsigned long windows[BOOST_CONTRACT_DETAIL_CHECK_THREADS_TOTALS_];
+        int last;
+    };
+
+    struct windows_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<windows_tag, windows> windows_var;
+    #else
+        typedef static_local_var<windows_tag, windows> windows_var;
+    #endif
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -9,72 +9,34 @@
 
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/detail/static_local_var.hpp>
-#include <boost/contract/detail/declspec.hpp>
-#include <boost/thread/mutex.hpp>
 #include <boost/noncopyable.hpp>
 
 namespace boost { namespace contract { namespace detail {
 
-#ifdef BOOST_MSVC
-    #pragma warning(push)
-    #pragma warning(disable: 4251) // Member w/o DLL spec (mutex_ type).
-#endif
-
 // RAII facility to disable assertions while checking other assertions.
-class BOOST_CONTRACT_DETAIL_DECLSPEC checking :
-    private boost::noncopyable // Non-copyable resource (might use mutex, etc.).
+// NOTE: State is a per-thread nesting counter (not a global flag guarded by a
+// mutex) so checking contracts in one thread never disables nor serializes
+// contract checking in other threads. All accesses are inlined, no lock.
+class checking :
+    private boost::noncopyable // Non-copyable resource (nesting counter).
 {
 public:
-    explicit checking() {
-        #ifndef BOOST_CONTRACT_DISABLE_THREADS
-            init_locked();
-        #else
-            init_unlocked();
-        #endif
-    }
-
-    ~checking() {
-        #ifndef BOOST_CONTRACT_DISABLE_THREADS
-            done_locked();
-        #else
-            done_unlocked();
-        #endif
-    }
-    
-    static bool already() {
-        #ifndef BOOST_CONTRACT_DISABLE_THREADS
-            return already_locked();
-        #else
-            return already_unlocked();
-        #endif
-    }
-
-private:
-    void init_unlocked();
-    void init_locked();
+    explicit checking() { ++depth::ref(); }
 
-    void done_unlocked();
-    void done_locked();
+    ~checking() { --depth::ref(); }
 
-    static bool already_unlocked();
-    static bool already_locked();
+    static bool already() { return depth::ref() != 0; }
 
-    struct mutex_tag;
-    typedef static_local_var<mutex_tag, boost::mutex> mutex;
-
-    struct checking_tag;
-    typedef static_local_var_init<checking_tag, bool, bool, false> flag;
+private:
+    struct depth_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var_init<depth_tag, unsigned, unsigned, 0> depth;
+    #else
+        typedef static_local_var_init<depth_tag, unsigned, unsigned, 0> depth;
+    #endif
 };
 
-#ifdef BOOST_MSVC
-    #pragma warning(pop)
-#endif
-
 } } } // namespace
 
-#ifdef BOOST_CONTRACT_HEADER_ONLY
-    #include <boost/contract/detail/inlined/detail/checking.hpp>
-#endif
-
 #endif // #include guard
 
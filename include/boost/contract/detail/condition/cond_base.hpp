@@ -21,16 +21,44 @@
 #if     !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
         !defined(BOOST_CONTRACT_NO_OLDS) || \
         !defined(BOOST_CONTRACT_NO_EXEPTS)
-    #include <boost/function.hpp>
+    #include <boost/contract/detail/inline_ftor.hpp>
+#endif
+#include <boost/contract/detail/next_contract.hpp>
+#include <boost/contract/detail/check_cost.hpp>
+#ifdef BOOST_CONTRACT_CHECK_DEPTH
+    #include <boost/contract/detail/call_depth.hpp>
+#endif
+#include <boost/contract/scoped_policy.hpp>
+#include <boost/contract/detail/contract_site.hpp>
+#ifdef BOOST_CONTRACT_METRICS
+    #include <boost/contract/detail/metrics.hpp>
+    #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+        #include <boost/contract/detail/checking.hpp>
+    #endif
+#endif
+#ifdef BOOST_CONTRACT_PROBES
+    #include <boost/contract/detail/probe.hpp>
+#endif
+#ifdef BOOST_CONTRACT_TRACE
+    #include <boost/contract/detail/trace.hpp>
+#endif
+#ifdef BOOST_CONTRACT_OBSERVER
+    #include <boost/contract/detail/observer.hpp>
 #endif
 #include <boost/noncopyable.hpp>
 #ifndef BOOST_CONTRACT_ON_MISSING_CHECK_DECL
     #include <boost/assert.hpp>
 #endif
 #include <boost/config.hpp>
+#include <cstddef>
 
 namespace boost { namespace contract { namespace detail {
 
+class cond_storage; // Fwd decl (its header includes this one).
+
+// Tag for move ctors (only used to relocate objects between cond_storage).
+struct cond_move {};
+
 class cond_base : // Base to hold all contract objects for RAII.
     private boost::noncopyable // Avoid copying possible user's ftor captures.
 {
@@ -41,20 +69,132 @@ public:
         #ifndef BOOST_CONTRACT_NO_CONDITIONS
             , from_(from)
             , failed_(false)
+            , sampled_out_(false)
+            , cost_(0)
+            #ifdef BOOST_CONTRACT_CHECK_DEPTH
+                , counted_(false)
+            #endif
+            , unchecked_(0)
+            #ifdef BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+                , where_(0)
+            #endif
+            #ifdef BOOST_CONTRACT_METRICS
+                , metrics_(0)
+            #endif
+            #ifdef BOOST_CONTRACT_TRACE
+                , trace_body_(0)
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                , observing_(0)
+            #endif
         #endif
     {}
+
+    explicit cond_base(cond_base& other, cond_move) :
+          BOOST_CONTRACT_ERROR_missing_check_object_declaration(
+                other.BOOST_CONTRACT_ERROR_missing_check_object_declaration)
+        , init_asserted_(other.init_asserted_)
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            , from_(other.from_)
+            , failed_(other.failed_)
+            , sampled_out_(other.sampled_out_)
+            , cost_(other.cost_)
+            #ifdef BOOST_CONTRACT_CHECK_DEPTH
+                , counted_(other.counted_)
+            #endif
+            , unchecked_(other.unchecked_)
+            #ifdef BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+                , where_(other.where_)
+            #endif
+            #ifdef BOOST_CONTRACT_METRICS
+                , metrics_(other.metrics_)
+            #endif
+            #ifdef BOOST_CONTRACT_TRACE
+                , trace_body_(other.trace_body_)
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                , observing_(0) // No phase active while moved.
+            #endif
+        #endif
+    {
+        #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+                defined(BOOST_CONTRACT_CHECK_DEPTH)
+            other.counted_ = false; // Only moved-to leaves call depth.
+        #endif
+        // Move, so no functor copy (and moved-from owns no functor).
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            pre_.move(other.pre_);
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            old_.move(other.old_);
+        #endif
+        #ifndef BOOST_CONTRACT_NO_EXCEPTS
+            except_.move(other.except_);
+        #endif
+    }
     
     // Can override for checking on exit, but should call assert_initialized().
     virtual ~cond_base() BOOST_NOEXCEPT_IF(false) {
         // Catch error (but later) even if overrides miss assert_initialized().
         if(!init_asserted_) assert_initialized();
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            #ifdef BOOST_CONTRACT_TRACE
+                trace_body(); // If no exit check recorded it.
+            #endif
+            #ifdef BOOST_CONTRACT_CHECK_DEPTH
+                if(counted_) call_depth::exit(); // After derived exit checks.
+            #endif
+        #endif
     }
 
     void initialize() { // Must be called by owner ctor (i.e., check class).
         BOOST_CONTRACT_ERROR_missing_check_object_declaration = true;
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            // Before init checks (and only if set by this function).
+            next_contract const next = next_contract::consume();
+            sampled_out_ = next.sampled_out;
+            cost_ = next.cost;
+            #ifdef BOOST_CONTRACT_CHECK_DEPTH
+                counted_ = true;
+                if(call_depth::enter()) sampled_out_ = true; // Too deep.
+            #endif
+            // Same conditions at entry and exit (see scoped_policy).
+            unchecked_ = thread_policy::ref().unchecked;
+            if(unchecked_ == boost::contract::checked_all) sampled_out_ = true;
+            #ifdef BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+                where_ = next.where; // Null unless site given.
+            #endif
+            #ifdef BOOST_CONTRACT_DETAIL_PROBES
+                BOOST_CONTRACT_DETAIL_PROBE(contract, where_, !sampled_out_);
+            #endif
+            #ifdef BOOST_CONTRACT_METRICS
+                metrics_ = where_ ? metrics::find(where_) : 0;
+                if(metrics_) {
+                    metrics_block::add(metrics_->calls, 1);
+                    #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                        if(!sampled_out_ && !checking::already())
+                    #else
+                        if(!sampled_out_)
+                    #endif
+                    { metrics_block::add(metrics_->checks, 1); }
+                }
+            #endif
+        #endif
         this->init(); // So all inits (pre, old, post) done after owner decl.
+        #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+                defined(BOOST_CONTRACT_TRACE)
+            // Body from here to first exit check (or to destruction).
+            if(!sampled_out_ && trace::on() && this->traces_body()) {
+                trace_body_ = metrics::nanoseconds();
+            }
+        #endif
     }
     
+    // Construct in place in storage owned by check, etc. (defined in its header).
+    static void* operator new(std::size_t size, cond_storage& storage);
+    static void operator delete(void* ptr, cond_storage& storage);
+    static void operator delete(void* ptr) { ::operator delete(ptr); }
+    
     #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
         template<typename F>
         void set_pre(F const& f) { pre_ = f; }
@@ -70,6 +210,20 @@ public:
         void set_except(F const& f) { except_ = f; }
     #endif
 
+    #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+            defined(BOOST_CONTRACT_OBSERVER)
+        // Overridden by conds with obj, etc. (only if observer installed).
+        virtual void observe(boost::contract::observer_event& e) const {
+            e.where = where_;
+            e.from = from_;
+            e.object = 0;
+            e.subcontracted = false;
+        }
+
+        // Phase being checked (null if none or no observer installed).
+        observe_phase*& observing() { return observing_; }
+    #endif
+
 protected:
     void assert_initialized() { // Derived dtors must assert this at entry.
         init_asserted_ = true;
@@ -85,16 +239,47 @@ protected:
     }
     
     virtual void init() {} // Override for checking on entry.
+
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        bool has_pre() const { return !!pre_; }
+    #endif
+    
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        bool has_old() const { return !!old_; }
+    #endif
+    
+    #ifndef BOOST_CONTRACT_NO_EXCEPTS
+        bool has_except() const { return !!except_; }
+    #endif
     
     // Return true if actually checked calling user ftor.
     #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
         bool check_pre(bool throw_on_failure = false) {
             if(failed()) return true;
+            if(!checks(boost::contract::checked_preconditions)) return false;
+            metering m(cost_);
+            #ifdef BOOST_CONTRACT_METRICS
+                metrics_timer t(metrics_, metrics_preconditions);
+            #endif
+            #ifdef BOOST_CONTRACT_DETAIL_PROBES
+                probe_phase p(where_, metrics_preconditions);
+            #endif
+            #ifdef BOOST_CONTRACT_TRACE
+                trace_phase tr("preconditions", where_);
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                observe_phase o(*this, metrics_preconditions);
+            #endif
             try { if(pre_) pre_(); else return false; }
             catch(...) {
                 // Subcontracted pre must throw on failure (instead of
                 // calling failure handler) so to be checked in logic-or.
-                if(throw_on_failure) throw;
+                if(throw_on_failure) {
+                    #ifdef BOOST_CONTRACT_OBSERVER
+                        observe_failure(0); // This base pre failed.
+                    #endif
+                    throw;
+                }
                 fail(&boost::contract::precondition_failure);
             }
             return true;
@@ -104,6 +289,22 @@ protected:
     #ifndef BOOST_CONTRACT_NO_OLDS
         void copy_old() {
             if(failed()) return;
+            // Also pops old values of virtual calls, so same test for all.
+            if(!checks(boost::contract::checked_postconditions) &&
+                    !checks(boost::contract::checked_excepts)) return;
+            metering m(cost_);
+            #ifdef BOOST_CONTRACT_METRICS
+                metrics_timer t(metrics_, metrics_old_values);
+            #endif
+            #ifdef BOOST_CONTRACT_DETAIL_PROBES
+                probe_phase p(where_, metrics_old_values);
+            #endif
+            #ifdef BOOST_CONTRACT_TRACE
+                trace_phase tr("old_values", where_);
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                observe_phase o(*this, metrics_old_values);
+            #endif
             try { if(old_) old_(); }
             catch(...) { fail(&boost::contract::old_failure); }
         }
@@ -111,7 +312,24 @@ protected:
 
     #ifndef BOOST_CONTRACT_NO_EXCEPTS
         void check_except() {
+            #ifdef BOOST_CONTRACT_TRACE
+                trace_body();
+            #endif
             if(failed()) return;
+            if(!checks(boost::contract::checked_excepts)) return;
+            metering m(cost_);
+            #ifdef BOOST_CONTRACT_METRICS
+                metrics_timer t(metrics_, metrics_excepts);
+            #endif
+            #ifdef BOOST_CONTRACT_DETAIL_PROBES
+                probe_phase p(where_, metrics_excepts);
+            #endif
+            #ifdef BOOST_CONTRACT_TRACE
+                trace_phase tr("excepts", where_);
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                observe_phase o(*this, metrics_excepts);
+            #endif
             try { if(except_) except_(); }
             catch(...) { fail(&boost::contract::except_failure); }
         }
@@ -120,30 +338,111 @@ protected:
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         void fail(void (*h)(boost::contract::from)) {
             failed(true);
+            #ifdef BOOST_CONTRACT_METRICS
+                if(metrics_) metrics_block::add(metrics_->failures, 1);
+            #endif
+            #ifdef BOOST_CONTRACT_DETAIL_PROBES
+                BOOST_CONTRACT_DETAIL_PROBE(failure, where_,
+                        metrics_failure_phase(h));
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                observe_failure(h);
+            #endif
             if(h) h(from_);
         }
     
         // Virtual so overriding pub func can use virtual_::failed_ instead.
         virtual bool failed() const { return failed_; }
         virtual void failed(bool value) { failed_ = value; }
+
+        // Not checked at all (see boost::contract::sample).
+        bool sampled_out() const { return sampled_out_; }
+
+        // Null unless checking cost measured (see check_cost).
+        check_cost* cost() const { return cost_; }
+
+        #ifdef BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+            // Null unless contract site given (see boost::contract::sample).
+            site const* where() const { return where_; }
+        #endif
+
+        #ifdef BOOST_CONTRACT_METRICS
+            // Null unless contract site given (see boost::contract::metrics).
+            metrics_block* metrics() const { return metrics_; }
+        #endif
+
+        #ifdef BOOST_CONTRACT_TRACE
+            // Record body (once) when first exit check begins.
+            void trace_body() {
+                if(!trace_body_) return;
+                trace::record("body", where_, 0, trace_body_);
+                trace_body_ = 0;
+            }
+
+            // Overridden by base calls of subcontracting (their body skipped).
+            virtual bool traces_body() const { return true; }
+        #endif
+
+        // False if conditions not checked by this thread (see scoped_policy).
+        bool checks(boost::contract::checked_conditions c) const {
+            return !(unchecked_ & c);
+        }
     #endif
 
 private:
+    #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+            defined(BOOST_CONTRACT_OBSERVER)
+        // Notify failure of phase being checked (or of handler's phase).
+        void observe_failure(void (*h)(boost::contract::from)) {
+            if(observing_) {
+                observing_->notify(/* failed = */ true);
+                return;
+            }
+            boost::contract::observer* o = boost::contract::get_observer();
+            metrics_phase const p = metrics_failure_phase(h);
+            if(BOOST_LIKELY(!o) || p == metrics_phases) return;
+            boost::contract::observer_event e;
+            observe(e);
+            e.phase = static_cast<boost::contract::metrics::phase>(p);
+            e.failed = true;
+            e.nanoseconds = 0; // Not in a phase (e.g., subcontracted pre).
+            o->notify(e);
+        }
+    #endif
+
     bool BOOST_CONTRACT_ERROR_missing_check_object_declaration;
     bool init_asserted_; // Avoid throwing twice from dtors (undef behavior).
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         boost::contract::from from_;
         bool failed_;
+        bool sampled_out_;
+        check_cost* cost_;
+        #ifdef BOOST_CONTRACT_CHECK_DEPTH
+            bool counted_; // In call depth (so leave it on destruction).
+        #endif
+        unsigned unchecked_; // Conditions not checked (see scoped_policy).
+        #ifdef BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+            site const* where_;
+        #endif
+        #ifdef BOOST_CONTRACT_METRICS
+            metrics_block* metrics_;
+        #endif
+        #ifdef BOOST_CONTRACT_TRACE
+            boost::uint64_t trace_body_; // Body begin (0 if not recorded).
+        #endif
+        #ifdef BOOST_CONTRACT_OBSERVER
+            observe_phase* observing_;
+        #endif
     #endif
-    // Following use Boost.Function to handle also lambdas, binds, etc.
+    // Following type-erase also lambdas, binds, etc. (in place if they fit).
     #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
-        boost::function<void ()> pre_;
+        boost::contract::detail::inline_ftor<void ()> pre_;
     #endif
     #ifndef BOOST_CONTRACT_NO_OLDS
-        boost::function<void ()> old_;
+        boost::contract::detail::inline_ftor<void ()> old_;
     #endif
     #ifndef BOOST_CONTRACT_NO_EXCEPTS
-        boost::function<void ()> except_;
+        boost::contract::detail::inline_ftor<void ()> except_;
     #endif
 };
 
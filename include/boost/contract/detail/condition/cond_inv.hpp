@@ -12,6 +12,10 @@
 #include <boost/contract/detail/condition/cond_post.hpp>
 #ifndef BOOST_CONTRACT_NO_INVARIANTS
     #include <boost/contract/core/access.hpp>
+    #include <boost/contract/core/invariant_epoch.hpp>
+    #include <boost/type_traits/is_base_of.hpp>
+    #include <boost/type_traits/is_const.hpp>
+    #include <boost/type_traits/remove_cv.hpp>
     #include <boost/type_traits/add_pointer.hpp>
     #include <boost/type_traits/is_volatile.hpp>
     #include <boost/mpl/vector.hpp>
@@ -20,9 +24,14 @@
     #include <boost/mpl/copy_if.hpp>
     #include <boost/mpl/eval_if.hpp>
     #include <boost/mpl/not.hpp>
+    #include <boost/mpl/empty.hpp>
+    #include <boost/mpl/bool.hpp>
     #include <boost/mpl/and.hpp>
     #include <boost/mpl/placeholders.hpp>
     #include <boost/utility/enable_if.hpp>
+    #ifdef BOOST_CONTRACT_NO_NESTED_INVARIANTS
+        #include <boost/contract/detail/nested_object.hpp>
+    #endif
     #ifndef BOOST_CONTRACT_PERMISSIVE
         #include <boost/function_types/property_tags.hpp>
         #include <boost/static_assert.hpp>
@@ -99,7 +108,44 @@ public:
         #ifndef BOOST_CONTRACT_NO_CONDITIONS
             , obj_(obj)
         #endif
+        #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+            , nested_(false)
+            , pushed_(false)
+        #endif
     {}
+
+    explicit cond_inv(cond_inv& other, cond_move) :
+        cond_post<VR>(other, cond_move())
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            , obj_(other.obj_)
+        #endif
+        #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+            , nested_(other.nested_)
+            , pushed_(other.pushed_)
+        #endif
+    {
+        #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+            other.pushed_ = false; // Only moved-to pops obj.
+        #endif
+    }
+
+    #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+            defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+        ~cond_inv() BOOST_NOEXCEPT_IF(false) {
+            if(pushed_) nested_object::exit(); // After derived exit checks.
+        }
+    #endif
+
+    #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+            defined(BOOST_CONTRACT_OBSERVER)
+        void observe(boost::contract::observer_event& e) const /* override */ {
+            cond_post<VR>::observe(e);
+            e.object = obj_;
+        }
+    #endif
     
 protected:
     #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
@@ -118,16 +164,76 @@ protected:
         C* object() { return obj_; }
     #endif
 
+    #ifndef BOOST_CONTRACT_NO_INVARIANTS
+        // Object might change, so check its next entry inv (if epoch, and not
+        // for const members that cannot change it).
+        void bump_epoch() {
+            bump_epoch(boost::mpl::bool_<boost::is_base_of<
+                boost::contract::invariant_epoch,
+                typename boost::remove_cv<C>::type
+            >::value && !boost::is_const<C>::value>());
+        }
+
+        #ifdef BOOST_CONTRACT_NO_NESTED_INVARIANTS
+            // Called on entry of outer calls on obj (so no inv for inner ones).
+            void enter_object() {
+                nested_ = nested_object::enter(obj_, pushed_);
+            }
+
+            bool nested() const { return nested_; }
+
+            // Base calls of subcontracting skip inv as their overriding call.
+            void nested(bool n) { nested_ = n; }
+        #endif
+
+        // RAII to bump epoch on scope exit (e.g., after entry inv checked).
+        class epoch_bump {
+        public:
+            explicit epoch_bump(cond_inv* cond) : cond_(cond) {}
+            ~epoch_bump() { cond_->bump_epoch(); }
+        private:
+            cond_inv* cond_;
+        };
+    #endif
+
 private:
     #ifndef BOOST_CONTRACT_NO_INVARIANTS
         // Static, cv, and const inv in that order as strongest qualifier first.
         void check_inv(bool on_entry, bool static_only, bool const_and_cv) {
+            #ifdef BOOST_CONTRACT_TRACE
+                if(!on_entry) this->trace_body();
+            #endif
             if(this->failed()) return;
+            #ifdef BOOST_CONTRACT_NO_NESTED_INVARIANTS
+                if(nested_) return; // Checked by outer call on same obj.
+            #endif
+            if(!this->checks(on_entry ?
+                    boost::contract::checked_entry_invariants :
+                    boost::contract::checked_exit_invariants)) return;
+            metering m(this->cost());
+            #ifdef BOOST_CONTRACT_METRICS
+                metrics_timer t(this->metrics(), on_entry ?
+                        metrics_entry_invariants : metrics_exit_invariants);
+            #endif
+            #ifdef BOOST_CONTRACT_DETAIL_PROBES
+                probe_phase p(this->where(), on_entry ?
+                        metrics_entry_invariants : metrics_exit_invariants);
+            #endif
+            #ifdef BOOST_CONTRACT_TRACE
+                trace_phase tr(on_entry ? "entry_invariants" :
+                        "exit_invariants", this->where());
+            #endif
+            #ifdef BOOST_CONTRACT_OBSERVER
+                observe_phase o(*this, on_entry ?
+                        metrics_entry_invariants : metrics_exit_invariants);
+            #endif
             try {
                 // Static members only check static inv.
                 check_static_inv<C>();
                 if(!static_only) {
-                    if(const_and_cv) {
+                    if(on_entry && epoch_unchanged(has_epoch())) {
+                        // Checked at exit since last obj change, skip.
+                    } else if(const_and_cv) {
                         check_cv_inv<C>();
                         check_const_inv<C>();
                     } else if(boost::is_volatile<C>::value) {
@@ -135,6 +241,7 @@ private:
                     } else {
                         check_const_inv<C>();
                     }
+                    if(!on_entry) epoch_checked(has_epoch()); // Passed.
                 }
             } catch(...) {
                 if(on_entry) {
@@ -143,6 +250,32 @@ private:
             }
         }
         
+        // Volatile members still bump epoch, but never skip nor record it.
+        typedef boost::mpl::bool_<boost::is_base_of<
+            boost::contract::invariant_epoch,
+            typename boost::remove_cv<C>::type
+        >::value && !boost::is_volatile<C>::value> has_epoch;
+
+        // C-style cast so also private base (and cast away volatile, but epoch
+        // atomics are never volatile).
+        boost::contract::invariant_epoch const& epoch() const {
+            return *(boost::contract::invariant_epoch const*)obj_;
+        }
+
+        bool epoch_unchanged(boost::mpl::false_) const { return false; }
+        bool epoch_unchanged(boost::mpl::true_) const {
+            return epoch().template unchanged<
+                    typename boost::remove_cv<C>::type>();
+        }
+
+        void epoch_checked(boost::mpl::false_) const {}
+        void epoch_checked(boost::mpl::true_) const {
+            epoch().template checked<typename boost::remove_cv<C>::type>();
+        }
+
+        void bump_epoch(boost::mpl::false_) const {}
+        void bump_epoch(boost::mpl::true_) const { epoch().bump(); }
+
         template<class C_>
         typename boost::disable_if<
                 boost::contract::access::has_const_invariant<C_> >::type
@@ -173,50 +306,64 @@ private:
                 boost::contract::access::has_static_invariant<C_> >::type
         check_static_inv() {
             // SFINAE HAS_STATIC_... returns true even when member is inherited
-            // so extra run-time check here (not the same for non static).
+            // so extra check here (not the same for non static), but without
+            // throwing and evaluated at most once per class.
             if(!inherited<boost::contract::access::has_static_invariant,
                     boost::contract::access::static_invariant_addr>::apply()) {
                 boost::contract::access::static_invariant<C_>();
             }
         }
 
-        // Check if class's func is inherited from its base types or not.
+        // Check if class's func is inherited from its base types or not (known
+        // at compile-time if no base has func, otherwise computed only once).
         template<template<class> class HasFunc, template<class> class FuncAddr>
         struct inherited {
             static bool apply() {
-                try {
-                    boost::mpl::for_each<
-                        // For now, no reason to deeply search inheritance tree
-                        // (SFINAE HAS_STATIC_... already fails in that case).
-                        typename boost::mpl::transform<
-                            typename boost::mpl::copy_if<
-                                typename boost::mpl::eval_if<boost::contract::
-                                        access::has_base_types<C>,
-                                    typename boost::contract::access::
-                                            base_types_of<C>
-                                ,
-                                    boost::mpl::vector<>
-                                >::type,
-                                HasFunc<boost::mpl::_1>
-                            >::type,
-                            boost::add_pointer<boost::mpl::_1>
-                        >::type
-                    >(compare_func_addr());
-                } catch(signal_equal const&) { return true; }
-                return false;
+                return apply(typename boost::mpl::empty<bases>::type());
             }
 
         private:
-            class signal_equal {}; // Except. to stop for_each as soon as found.
+            // For now, no reason to deeply search inheritance tree (SFINAE
+            // HAS_STATIC_... already fails in that case).
+            typedef typename boost::mpl::copy_if<
+                typename boost::mpl::eval_if<boost::contract::access::
+                        has_base_types<C>,
+                    typename boost::contract::access::base_types_of<C>
+                ,
+                    boost::mpl::vector<>
+                >::type,
+                HasFunc<boost::mpl::_1>
+            >::type bases;
+
+            static bool apply(boost::mpl::true_) { return false; }
+
+            static bool apply(boost::mpl::false_) {
+                // Func addresses never change, so compare them only once.
+                static bool const equal = compare();
+                return equal;
+            }
+
+            static bool compare() {
+                bool equal = false;
+                boost::mpl::for_each<typename boost::mpl::transform<bases,
+                        boost::add_pointer<boost::mpl::_1> >::type>(
+                                compare_func_addr(equal));
+                return equal;
+            }
 
             struct compare_func_addr {
+                explicit compare_func_addr(bool& equal) : equal_(equal) {}
+
                 template<typename B>
                 void operator()(B*) {
                     // Inherited func has same addr as in its base.
                     if(FuncAddr<C>::apply() == FuncAddr<B>::apply()) {
-                        throw signal_equal();
+                        equal_ = true;
                     }
                 }
+
+            private:
+                bool& equal_;
             };
         };
     #endif
@@ -224,6 +371,11 @@ private:
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         C* obj_;
     #endif
+    #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+            defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+        bool nested_;
+        bool pushed_;
+    #endif
 };
 
 } } } // namespace
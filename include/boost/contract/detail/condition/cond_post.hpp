@@ -14,13 +14,43 @@
 #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
     #include <boost/contract/detail/type_traits/optional.hpp>
     #include <boost/optional.hpp>
-    #include <boost/function.hpp>
+    #include <boost/contract/detail/inline_ftor.hpp>
     #include <boost/type_traits/remove_reference.hpp>
     #include <boost/mpl/if.hpp>
 #endif
 
 /* PRIVATE */
 
+#ifdef BOOST_CONTRACT_METRICS
+    #define BOOST_CONTRACT_DETAIL_COND_POST_METRICS_TIMER_ \
+        metrics_timer t(metrics(), metrics_postconditions);
+#else
+    #define BOOST_CONTRACT_DETAIL_COND_POST_METRICS_TIMER_ /* nothing */
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_PROBES
+    #define BOOST_CONTRACT_DETAIL_COND_POST_PROBE_PHASE_ \
+        probe_phase p(where(), metrics_postconditions);
+#else
+    #define BOOST_CONTRACT_DETAIL_COND_POST_PROBE_PHASE_ /* nothing */
+#endif
+
+#ifdef BOOST_CONTRACT_TRACE
+    #define BOOST_CONTRACT_DETAIL_COND_POST_TRACE_BODY_ trace_body();
+    #define BOOST_CONTRACT_DETAIL_COND_POST_TRACE_PHASE_ \
+        trace_phase tr("postconditions", where());
+#else
+    #define BOOST_CONTRACT_DETAIL_COND_POST_TRACE_BODY_ /* nothing */
+    #define BOOST_CONTRACT_DETAIL_COND_POST_TRACE_PHASE_ /* nothing */
+#endif
+
+#ifdef BOOST_CONTRACT_OBSERVER
+    #define BOOST_CONTRACT_DETAIL_COND_POST_OBSERVE_PHASE_ \
+        observe_phase o(*this, metrics_postconditions);
+#else
+    #define BOOST_CONTRACT_DETAIL_COND_POST_OBSERVE_PHASE_ /* nothing */
+#endif
+
 #define BOOST_CONTRACT_DETAIL_COND_POST_DEF_( \
         result_type, result_param, ftor_type, ftor_var, ftor_call) \
     public: \
@@ -29,13 +59,25 @@
     \
     protected: \
         void check_post(result_type const& result_param) { \
+            BOOST_CONTRACT_DETAIL_COND_POST_TRACE_BODY_ \
             if(failed()) return; \
+            if(!checks(boost::contract::checked_postconditions)) return; \
+            metering m(cost()); \
+            BOOST_CONTRACT_DETAIL_COND_POST_METRICS_TIMER_ \
+            BOOST_CONTRACT_DETAIL_COND_POST_PROBE_PHASE_ \
+            BOOST_CONTRACT_DETAIL_COND_POST_TRACE_PHASE_ \
+            BOOST_CONTRACT_DETAIL_COND_POST_OBSERVE_PHASE_ \
             try { if(ftor_var) { ftor_call; } } \
             catch(...) { fail(&boost::contract::postcondition_failure); } \
         } \
+        \
+        void move_post(cond_post& other) { ftor_var.move(other.ftor_var); } \
+        \
+        bool has_post() const { return !!ftor_var; } \
     \
     private: \
-        boost::function<ftor_type> ftor_var; /* Boost.Func for lambdas, etc. */
+        /* In place (if fits) for lambdas, etc. */ \
+        boost::contract::detail::inline_ftor<ftor_type> ftor_var;
 
 /* CODE */
 
@@ -45,6 +87,13 @@ template<typename VR>
 class cond_post : public cond_base { // Non-copyable base.
 public:
     explicit cond_post(boost::contract::from from) : cond_base(from) {}
+
+    explicit cond_post(cond_post& other, cond_move) :
+            cond_base(other, cond_move()) {
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            this->move_post(other);
+        #endif
+    }
     
     #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
         private: typedef typename boost::mpl::if_<is_optional<VR>,
@@ -69,6 +118,13 @@ template<>
 class cond_post<none> : public cond_base { // Non-copyable base.
 public:
     explicit cond_post(boost::contract::from from) : cond_base(from) {}
+
+    explicit cond_post(cond_post& other, cond_move) :
+            cond_base(other, cond_move()) {
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            this->move_post(other);
+        #endif
+    }
     
     #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
         BOOST_CONTRACT_DETAIL_COND_POST_DEF_(
@@ -0,0 +1,196 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_COND_STORAGE_HPP_
+#define BOOST_CONTRACT_DETAIL_COND_STORAGE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/condition/cond_base.hpp>
+#include <boost/contract/detail/debug.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+#include <new>
+#include <cstddef>
+
+/* PRIVATE */
+
+// Per-thread buffers (more only needed by contracts specified while copying
+// functors passed to specify_... of other contracts, then heap is used).
+#define BOOST_CONTRACT_DETAIL_COND_STORAGE_SLOTS_ 2
+
+/* CODE */
+
+namespace boost { namespace contract { namespace detail {
+
+// Per-thread buffers holding contract objects from function(), etc. until check
+// moves them into its own buffer (so there is only one buffer per call on the
+// stack). That happens at the end of the same full-expression, so buffers are
+// taken and given back in stack order (unless users store specify_... objects,
+// handled by popping only given back buffers from the top of the stack).
+class cond_slots {
+public:
+    static void* take() { // Null if none left (so heap must be used instead).
+        slots& s = stack::ref();
+        if(s.size == BOOST_CONTRACT_DETAIL_COND_STORAGE_SLOTS_) return 0;
+        s.used[s.size] = true;
+        return s.buffers[s.size++].data;
+    }
+
+    static void give_back(void* address) {
+        slots& s = stack::ref();
+        for(unsigned i = 0; i < s.size; ++i) {
+            if(s.buffers[i].data == address) s.used[i] = false;
+        }
+        while(s.size > 0 && !s.used[s.size - 1]) --s.size;
+    }
+
+private:
+    union buffer { // POD (for pre-C++11 thread-local storage).
+        char data[BOOST_CONTRACT_CHECK_BUFFER_SIZE > 0 ?
+                BOOST_CONTRACT_CHECK_BUFFER_SIZE : 1];
+        boost::detail::max_align align;
+    };
+
+    struct slots {
+        buffer buffers[BOOST_CONTRACT_DETAIL_COND_STORAGE_SLOTS_];
+        bool used[BOOST_CONTRACT_DETAIL_COND_STORAGE_SLOTS_];
+        unsigned size;
+    };
+
+    struct stack_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<stack_tag, slots> stack;
+    #else
+        typedef static_local_var<stack_tag, slots> stack;
+    #endif
+};
+
+// Own contract object in place (no heap allocation) if it fits the buffer,
+// otherwise on heap (so users can tune BOOST_CONTRACT_CHECK_BUFFER_SIZE).
+// NOTE: Contract objects are moved from one storage to another (from specify_...
+// objects to check objects) as their owners are moved. Moved-from objects are
+// never destructed because their destructors would check contracts, their
+// storage is just reused (so their move ctors must leave them owning nothing).
+// This class uses per-thread buffers (for specify_... objects), cond_buffer
+// below uses its own buffer (for check objects).
+class cond_storage : // Non-copyable (owner of contract object).
+    private boost::noncopyable
+{
+public:
+    cond_storage() : buffer_(0), cond_(0), heap_(false), relocate_(0) {}
+
+    ~cond_storage() BOOST_NOEXCEPT_IF(false) { // Dtor checks contracts.
+        if(!cond_) return;
+        if(heap_) delete cond_; // Deallocates even if dtor throws.
+        else cond_->~cond_base(); // Slot given back even if dtor throws.
+    }
+
+    cond_base* get() const { return cond_; }
+
+    // Called by cond_base::operator new(size, storage).
+    void* allocate(std::size_t size) {
+        BOOST_CONTRACT_DETAIL_DEBUG(!cond_);
+        if(size <= BOOST_CONTRACT_CHECK_BUFFER_SIZE) {
+            if(buffer_) return buffer_;
+            if((slot_.address = cond_slots::take())) return slot_.address;
+        }
+        heap_ = true;
+        return ::operator new(size);
+    }
+
+    // Called by cond_base::operator delete(ptr, storage) if ctor throws.
+    void deallocate(void* ptr) {
+        if(heap_) ::operator delete(ptr);
+        heap_ = false;
+        slot_.give_back();
+    }
+
+    // Record object constructed by `new (storage) Cond(...)` (so it can move).
+    template<class Cond>
+    void reset(Cond* cond) {
+        BOOST_STATIC_ASSERT_MSG(
+            boost::alignment_of<Cond>::value <=
+                    boost::alignment_of<boost::detail::max_align>::value,
+            "contract object alignment not supported"
+        );
+        BOOST_CONTRACT_DETAIL_DEBUG(!cond_);
+        cond_ = cond;
+        relocate_ = &relocate<Cond>;
+    }
+
+    void move(cond_storage& other) { // This must not own an object yet.
+        BOOST_CONTRACT_DETAIL_DEBUG(!cond_);
+        if(!other.cond_) return;
+        if(other.heap_) cond_ = other.cond_; // Just transfer ownership.
+        else if(buffer_) cond_ = other.relocate_(buffer_, *other.cond_);
+        else { // Just transfer ownership of per-thread buffer.
+            BOOST_CONTRACT_DETAIL_DEBUG(other.slot_.address);
+            cond_ = other.cond_;
+            slot_.address = other.slot_.address;
+            other.slot_.address = 0;
+        }
+        heap_ = other.heap_;
+        relocate_ = other.relocate_;
+        other.cond_ = 0;
+        other.heap_ = false;
+        other.slot_.give_back(); // Now, so calls checked next can reuse it.
+    }
+
+protected:
+    explicit cond_storage(void* buffer) : buffer_(buffer), cond_(0),
+            heap_(false), relocate_(0) {}
+
+private:
+    template<class Cond>
+    static cond_base* relocate(void* address, cond_base& from) {
+        return ::new(address) Cond(static_cast<Cond&>(from), cond_move());
+    }
+
+    struct slot { // Member so given back after dtor body, even if it throws.
+        slot() : address(0) {}
+        ~slot() { give_back(); }
+
+        void give_back() {
+            if(address) cond_slots::give_back(address);
+            address = 0;
+        }
+
+        void* address;
+    };
+
+    slot slot_;
+    void* buffer_;
+    cond_base* cond_;
+    bool heap_;
+    cond_base* (*relocate_)(void*, cond_base&);
+};
+
+class cond_buffer : public cond_storage {
+public:
+    cond_buffer() : cond_storage(buffer_.address()) {}
+
+private:
+    boost::aligned_storage<BOOST_CONTRACT_CHECK_BUFFER_SIZE,
+            boost::alignment_of<boost::detail::max_align>::value> buffer_;
+};
+
+inline void* cond_base::operator new(std::size_t size, cond_storage& storage) {
+    return storage.allocate(size);
+}
+
+inline void cond_base::operator delete(void* ptr, cond_storage& storage) {
+    storage.deallocate(ptr);
+}
+
+} } } // namespace
+
+#endif // #include guard
+
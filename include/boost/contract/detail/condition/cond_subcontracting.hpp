@@ -25,7 +25,13 @@
     #include <boost/contract/detail/none.hpp>
     #include <boost/contract/detail/name.hpp>
     #include <boost/type_traits/add_pointer.hpp>
+    #include <boost/type_traits/aligned_storage.hpp>
+    #include <boost/type_traits/alignment_of.hpp>
     #include <boost/mpl/fold.hpp>
+    #include <boost/mpl/size.hpp>
+    #include <boost/mpl/find.hpp>
+    #include <boost/mpl/begin_end.hpp>
+    #include <boost/mpl/distance.hpp>
     #include <boost/mpl/contains.hpp>
     #include <boost/mpl/empty.hpp>
     #include <boost/mpl/push_back.hpp>
@@ -40,6 +46,15 @@
     #endif
     #include <boost/preprocessor/punctuation/comma_if.hpp>
     #include <boost/config.hpp>
+    #include <cstring>
+    #include <new>
+    #ifdef BOOST_CONTRACT_SINGLE_PASS_SUBCONTRACTING
+        #include <exception>
+    #endif
+#endif
+#if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
+        !defined(BOOST_CONTRACT_NO_EXIT_INVARIANTS)
+    #include <boost/mpl/or.hpp>
 #endif
 #include <boost/mpl/vector.hpp>
 #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) || \
@@ -53,19 +68,57 @@
 #endif
 #if     !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
         !defined(BOSOT_CONTRACT_NO_EXCEPTS)
-    #include <boost/any.hpp>
     #include <boost/optional.hpp>
     #include <boost/type_traits/remove_reference.hpp>
     #include <boost/utility/enable_if.hpp>
     #include <typeinfo>
 #endif
+#ifdef BOOST_CONTRACT_TRACE
+    #include <typeinfo>
+#endif
 
 namespace boost { namespace contract { namespace detail {
 
 namespace cond_subcontracting_ {
-    // Exception signals (must not inherit).
+    // Exception signal only used to skip base function bodies on base calls
+    // (must not inherit). Base call results are instead returned via virtual_.
+    // NOTE: Base contracts are declared within base bodies (by the check object
+    // constructed there) so returning from them without running the rest of
+    // their bodies requires this throw (once per base call, skip_base avoids
+    // base calls instead).
     class signal_no_error {};
-    class signal_not_checked {};
+
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        // Static info of result types (its address used as type tag).
+        struct result_type_info {
+            // Only used if tags differ (same type in different DLLs, etc.).
+            std::type_info const& (*ptr_type)();
+            std::type_info const& (*type)(); // For error messages.
+        };
+
+        template<typename T>
+        struct result_type_of {
+            static std::type_info const& ptr_type() { return typeid(T*); }
+            static std::type_info const& type() { return typeid(T); }
+            static result_type_info const info;
+        };
+
+        template<typename T>
+        result_type_info const result_type_of<T>::info = {
+            &result_type_of<T>::ptr_type,
+            &result_type_of<T>::type
+        };
+    #endif
+
+    // Functors specified by base contracts (as returned via virtual_).
+    enum base_ftors_enum {
+        base_ftors_known = 0x01,
+        base_ftors_pre = 0x02,
+        base_ftors_old = 0x04,
+        base_ftors_post = 0x08,
+        base_ftors_except = 0x10,
+        base_ftors_old_init = 0x20 // Base pushed old values at body.
+    };
 }
 
 // O, VR, F, and Args-i can be none types (but C cannot).
@@ -159,6 +212,7 @@ public:
         #endif
     {
         #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            std::memset(base_ftors_, 0, sizeof base_ftors_); // All unknown.
             if(v) {
                 base_call_ = true;
                 v_ = v; // Invariant: v_ never null if base_call_.
@@ -166,11 +220,13 @@ public:
             } else {
                 base_call_ = false;
                 if(!boost::mpl::empty<overridden_bases>::value) {
-                    v_ = new boost::contract::virtual_(
+                    v_ = ::new(own_v_.address()) boost::contract::virtual_(
                             boost::contract::virtual_::no_action);
                     #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
                         v_->result_ptr_ = &r_;
-                        v_->result_type_name_ = typeid(VR).name();
+                        v_->result_type_ = &cond_subcontracting_::
+                                result_type_of<typename boost::remove_reference<
+                                        VR>::type>::info;
                         v_->result_optional_ = is_optional<VR>::value;
                     #endif
                 } else v_ = 0;
@@ -178,9 +234,52 @@ public:
         #endif
     }
 
+    explicit cond_subcontracting(cond_subcontracting& other, cond_move) :
+        cond_inv<VR, C>(other, cond_move())
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            , r_(other.r_)
+        #endif
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            , v_(other.v_)
+            , base_call_(other.base_call_)
+            BOOST_CONTRACT_DETAIL_TVARIADIC_COMMA(BOOST_CONTRACT_MAX_ARGS)
+            BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_COPY_Z(1,
+                    BOOST_CONTRACT_MAX_ARGS, args_, other.args_)
+        #endif
+    {
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            std::memcpy(base_ftors_, other.base_ftors_, sizeof base_ftors_);
+            if(!base_call_ && other.v_) { // Move own v_ (nothing pushed yet).
+                BOOST_CONTRACT_DETAIL_DEBUG(other.v_->action_ ==
+                        boost::contract::virtual_::no_action);
+                v_ = ::new(own_v_.address()) boost::contract::virtual_(
+                        boost::contract::virtual_::no_action);
+                #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                        defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+                    v_->nested_ = other.v_->nested_;
+                #endif
+                #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                    v_->result_ptr_ = other.v_->result_ptr_;
+                    v_->result_type_ = other.v_->result_type_;
+                    v_->result_optional_ = other.v_->result_optional_;
+                #endif
+                other.v_->~virtual_(); // Moved-from objects never destructed.
+            }
+            other.v_ = 0; // This now owns v_ (if not base_call_).
+        #endif
+    }
+
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         virtual ~cond_subcontracting() BOOST_NOEXCEPT_IF(false) {
-            if(!base_call_) delete v_;
+            if(!base_call_ && v_) v_->~virtual_();
+        }
+    #endif
+
+    #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+            defined(BOOST_CONTRACT_OBSERVER)
+        void observe(boost::contract::observer_event& e) const /* override */ {
+            cond_inv<VR, C>::observe(e);
+            e.subcontracted = base_call_;
         }
     #endif
 
@@ -192,6 +291,19 @@ protected:
         }
     #endif
     
+    #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+            defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+        // Overriding call detects nesting on obj, base calls get it from v.
+        void enter_subcontracted_object() {
+            if(base_call_) {
+                this->nested(v_->nested_);
+            } else {
+                this->enter_object();
+                if(v_) v_->nested_ = this->nested();
+            }
+        }
+    #endif
+
     #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
         void check_subcontracted_entry_inv() {
             exec_and(boost::contract::virtual_::check_entry_inv,
@@ -218,6 +330,9 @@ protected:
 
     #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
         void check_subcontracted_exit_inv() {
+            #ifdef BOOST_CONTRACT_TRACE
+                this->trace_body(); // Before bases (so end of body).
+            #endif
             exec_and(boost::contract::virtual_::check_exit_inv,
                     &cond_subcontracting::check_exit_inv);
         }
@@ -225,6 +340,9 @@ protected:
 
     #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
         void check_subcontracted_post() {
+            #ifdef BOOST_CONTRACT_TRACE
+                this->trace_body(); // Before bases (so end of body).
+            #endif
             exec_and(boost::contract::virtual_::check_post,
                     &cond_subcontracting::check_virtual_post);
         }
@@ -232,6 +350,9 @@ protected:
 
     #ifndef BOOST_CONTRACT_NO_EXCEPTS
         void check_subcontracted_except() {
+            #ifdef BOOST_CONTRACT_TRACE
+                this->trace_body(); // Before bases (so end of body).
+            #endif
             exec_and(boost::contract::virtual_::check_except,
                     &cond_subcontracting::check_virtual_except);
         }
@@ -249,6 +370,10 @@ protected:
             if(v_) v_->failed_ = value;
             else cond_base::failed(value);
         }
+
+        #ifdef BOOST_CONTRACT_TRACE
+            bool traces_body() const /* override */ { return !base_call_; }
+        #endif
     #endif
 
 private:
@@ -281,37 +406,46 @@ private:
             boost::optional<r_type const&> r; // No result copy in this code.
             if(!base_call_) r = optional_get(r_);
             else if(v_->result_optional_) {
-                try {
-                    r = **boost::any_cast<boost::optional<r_type>*>(
-                            v_->result_ptr_);
-                } catch(boost::bad_any_cast const&) {
-                    try { // Handle optional<...&>.
-                        r = **boost::any_cast<boost::optional<r_type&>*>(
-                                v_->result_ptr_);
-                    } catch(boost::bad_any_cast const&) {
-                        try {
-                            throw boost::contract::bad_virtual_result_cast(v_->
-                                    result_type_name_, typeid(r_type).name());
-                        } catch(...) {
-                            this->fail(&boost::contract::postcondition_failure);
-                        }
-                    }
-                }
+                if(boost::optional<r_type>* p =
+                        virtual_result<boost::optional<r_type> >()) {
+                    r = **p;
+                } else if(boost::optional<r_type&>* p = // Handle optional<T&>.
+                        virtual_result<boost::optional<r_type&> >()) {
+                    r = **p;
+                } else bad_virtual_result<r_type>();
             } else {
-                try {
-                    r = *boost::any_cast<r_type*>(v_->result_ptr_);
-                } catch(boost::bad_any_cast const&) {
-                    try {
-                        throw boost::contract::bad_virtual_result_cast(
-                                v_->result_type_name_, typeid(r_type).name());
-                    } catch(...) {
-                        this->fail(&boost::contract::postcondition_failure);
-                    }
-                }
+                if(r_type* p = virtual_result<r_type>()) r = *p;
+                else bad_virtual_result<r_type>();
             }
             check_virtual_post_with_result<VR>(r);
         }
 
+        // Result of overriding function if of type R (no exception, no RTTI).
+        template<typename R>
+        R* virtual_result() const {
+            cond_subcontracting_::result_type_info const* t =
+                    static_cast<cond_subcontracting_::result_type_info const*>(
+                            v_->result_type_);
+            if(t == &cond_subcontracting_::result_type_of<R>::info ||
+                    t->ptr_type() == typeid(R*)) {
+                return static_cast<R*>(const_cast<void*>(v_->result_ptr_));
+            }
+            return 0;
+        }
+
+        template<typename R>
+        void bad_virtual_result() {
+            try {
+                throw boost::contract::bad_virtual_result_cast(
+                    static_cast<cond_subcontracting_::result_type_info const*>(
+                            v_->result_type_)->type().name(),
+                    typeid(R).name()
+                );
+            } catch(...) {
+                this->fail(&boost::contract::postcondition_failure);
+            }
+        }
+
         template<typename R_, typename Result>
         typename boost::enable_if<is_optional<R_> >::type
         check_virtual_post_with_result(Result const& r) {
@@ -340,18 +474,69 @@ private:
             boost::contract::virtual_::action_enum a,
             void (cond_subcontracting::* f)() = 0
         ) {
-            if(failed()) return;
-            if(!base_call_ || v_->action_ == a) {
-                if(!base_call_ && v_) {
-                    v_->action_ = a;
-                    boost::mpl::for_each<overridden_bases>(call_base(*this));
-                }
+            if(failed()) {
+                if(base_call_) return_to_overriding(/* checked = */ false);
+                return;
+            }
+            if(!base_call_ || base_action(a)) {
+                if(!base_call_ && v_) exec_and_bases(a);
                 if(f) (this->*f)();
-                if(base_call_) {
-                    throw cond_subcontracting_::signal_no_error();
+                if(base_call_ && !v_->actions_) {
+                    return_to_overriding(/* checked = */ true);
                 }
             }
         }
+
+        void exec_and_bases(boost::contract::virtual_::action_enum a) {
+            #ifdef BOOST_CONTRACT_SINGLE_PASS_SUBCONTRACTING
+                #if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) && \
+                        !defined(BOOST_CONTRACT_NO_OLDS)
+                    // Bases push old values at body when checking entry inv.
+                    if(a == boost::contract::virtual_::push_old_init_copy) {
+                        return;
+                    } else if(a == boost::contract::virtual_::check_entry_inv) {
+                        boost::mpl::for_each<overridden_bases>(call_base(*this,
+                                boost::contract::virtual_::push_old_init_copy,
+                                action_bit(a)));
+                        return;
+                    }
+                #endif
+                #if     !defined(BOOST_CONTRACT_NO_EXIT_INVARIANTS) && ( \
+                        !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
+                        !defined(BOOST_CONTRACT_NO_EXCEPTS))
+                    // Bases check post or except when checking exit inv.
+                    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                        if(a == boost::contract::virtual_::check_post) return;
+                    #endif
+                    #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                        if(a == boost::contract::virtual_::check_except) return;
+                    #endif
+                    if(a == boost::contract::virtual_::check_exit_inv) {
+                        boost::contract::virtual_::action_enum post_or_except =
+                                boost::contract::virtual_::no_action;
+                        if(std::uncaught_exception()) {
+                            #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                                post_or_except =
+                                        boost::contract::virtual_::check_except;
+                            #endif
+                        } else {
+                            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                                post_or_except =
+                                        boost::contract::virtual_::check_post;
+                            #endif
+                        }
+                        if(post_or_except !=
+                                boost::contract::virtual_::no_action) {
+                            // Post or except first (so bases pop old values).
+                            boost::mpl::for_each<overridden_bases>(call_base(
+                                    *this, post_or_except, action_bit(a)));
+                            return;
+                        }
+                    }
+                #endif
+            #endif
+            boost::mpl::for_each<overridden_bases>(call_base(*this, a));
+        }
     #endif
 
     #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
@@ -360,10 +545,12 @@ private:
             bool (cond_subcontracting::* f)(bool) = 0,
             void (*h)(boost::contract::from) = 0
         ) {
-            if(failed()) return;
-            if(!base_call_ || v_->action_ == a) {
+            if(failed()) {
+                if(base_call_) return_to_overriding(/* checked = */ false);
+                return;
+            }
+            if(!base_call_ || base_action(a)) {
                 if(!base_call_ && v_) {
-                    v_->action_ = a;
                     try { 
                         exec_or_bases<overridden_bases>();
                         return; // A base checked with no error (done).
@@ -379,12 +566,7 @@ private:
                 }
                 bool checked = f ?
                         (this->*f)(/* throw_on_failure = */ base_call_) : false;
-                if(base_call_) {
-                    if(!checked) {
-                        throw cond_subcontracting_::signal_not_checked();
-                    }
-                    throw cond_subcontracting_::signal_no_error();
-                }
+                if(base_call_) return_to_overriding(checked); // Always last.
             }
         }
         
@@ -396,43 +578,198 @@ private:
         typename boost::disable_if<boost::mpl::empty<Bases>, bool>::type
         exec_or_bases() {
             if(boost::mpl::empty<Bases>::value) return false;
+            bool checked;
             try {
-                call_base(*this)(typename boost::mpl::front<Bases>::type());
-            } catch(cond_subcontracting_::signal_not_checked const&) {
-                return exec_or_bases<
-                        typename boost::mpl::pop_front<Bases>::type>();
-            } catch(...) {
-                bool checked = false;
+                checked = call_base(*this,
+                        boost::contract::virtual_::check_pre)(
+                        typename boost::mpl::front<Bases>::type());
+            } catch(...) { // Base failed (stay in handler to report it later).
+                bool others_checked = false;
                 try {
-                    checked = exec_or_bases<
+                    others_checked = exec_or_bases<
                             typename boost::mpl::pop_front<Bases>::type>();
-                } catch(...) { checked = false; }
-                if(!checked) throw;
+                } catch(...) { others_checked = false; }
+                if(!others_checked) throw;
+                return true;
+            }
+            if(!checked) { // Base not checked (returned, no exception here).
+                return exec_or_bases<
+                        typename boost::mpl::pop_front<Bases>::type>();
             }
             return true;
         }
     #endif
     
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        static unsigned short action_bit(
+                boost::contract::virtual_::action_enum a) {
+            return static_cast<unsigned short>(1u << a);
+        }
+
+        // True if base call must execute this action now (then marked done).
+        bool base_action(boost::contract::virtual_::action_enum a) {
+            if(!(v_->actions_ & action_bit(a))) return false;
+            v_->actions_ &= static_cast<unsigned short>(~action_bit(a));
+            v_->action_ = a;
+            return true;
+        }
+
+        // Return to overriding function (via v_) skipping base function body.
+        void return_to_overriding(bool checked) {
+            unsigned char ftors = cond_subcontracting_::base_ftors_known;
+            #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                if(this->has_pre()) ftors |= cond_subcontracting_::
+                        base_ftors_pre;
+            #endif
+            #ifndef BOOST_CONTRACT_NO_OLDS
+                if(this->has_old()) ftors |= cond_subcontracting_::
+                        base_ftors_old;
+            #endif
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                if(this->has_post()) ftors |= cond_subcontracting_::
+                        base_ftors_post;
+            #endif
+            #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                if(this->has_except()) ftors |= cond_subcontracting_::
+                        base_ftors_except;
+            #endif
+            v_->base_checked_ = checked;
+            v_->base_ftors_ = ftors;
+            throw cond_subcontracting_::signal_no_error(); // Skip base body.
+        }
+
+        #if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
+                !defined(BOOST_CONTRACT_NO_EXIT_INVARIANTS)
+            template<class B>
+            struct base_has_inv : boost::mpl::or_<
+                boost::contract::access::has_static_invariant<B>,
+                boost::contract::access::has_const_invariant<B>,
+                boost::contract::access::has_cv_invariant<B>
+            > {};
+        #endif
+
+        // Skip calling base if it has nothing to do for current action (so
+        // subcontracting costs grow with base contracts, not with bases).
+        template<class B>
+        bool skip_base(boost::contract::virtual_::action_enum a,
+                unsigned char ftors) const {
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                if(a == boost::contract::virtual_::check_entry_inv) {
+                    return !base_has_inv<B>::value;
+                }
+            #endif
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                if(a == boost::contract::virtual_::check_exit_inv) {
+                    return !base_has_inv<B>::value;
+                }
+            #endif
+            if(!(ftors & cond_subcontracting_::base_ftors_known)) {
+                return false; // Must call base to know its contract.
+            }
+            #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                if(a == boost::contract::virtual_::check_pre) {
+                    return !(ftors & cond_subcontracting_::base_ftors_pre);
+                }
+            #endif
+            #ifndef BOOST_CONTRACT_NO_OLDS
+                if(a == boost::contract::virtual_::call_old_ftor) {
+                    return !(ftors & cond_subcontracting_::base_ftors_old);
+                }
+                // Base must pop its old values on post and except.
+                unsigned char olds = cond_subcontracting_::base_ftors_old |
+                        cond_subcontracting_::base_ftors_old_init;
+            #else
+                unsigned char olds = 0;
+            #endif
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                if(a == boost::contract::virtual_::check_post) {
+                    return !(ftors & (cond_subcontracting_::base_ftors_post |
+                            olds));
+                }
+            #endif
+            #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                if(a == boost::contract::virtual_::check_except) {
+                    return !(ftors & (cond_subcontracting_::
+                            base_ftors_except | olds));
+                }
+            #endif
+            return false; // Always call base for other actions.
+        }
+
         class call_base { // Copyable (as &).
         public:
-            explicit call_base(cond_subcontracting& me) : me_(me) {}
+            // Base executes first action, then others (in its own order).
+            explicit call_base(cond_subcontracting& me,
+                    boost::contract::virtual_::action_enum first,
+                    unsigned short others = 0) :
+                me_(me),
+                first_(first),
+                actions_(static_cast<unsigned short>(action_bit(first) |
+                        others))
+            {}
 
+            // Return true if base checked its contract (without errors).
             template<class B>
-            void operator()(B*) {
+            bool operator()(B*) {
                 BOOST_CONTRACT_DETAIL_DEBUG(me_.object());
                 BOOST_CONTRACT_DETAIL_DEBUG(me_.v_);
-                BOOST_CONTRACT_DETAIL_DEBUG(me_.v_->action_ !=
+                BOOST_CONTRACT_DETAIL_DEBUG(first_ !=
                         boost::contract::virtual_::no_action);
+                unsigned char& ftors = me_.base_ftors_[
+                        base_index<B>::value];
+                boost::contract::virtual_::action_enum first = first_;
+                unsigned short actions = 0;
+                for(unsigned a = 0; (1u << a) <= actions_; ++a) {
+                    if((actions_ & (1u << a)) && !me_.template skip_base<B>(
+                            boost::contract::virtual_::action_enum(a), ftors)) {
+                        actions |= static_cast<unsigned short>(1u << a);
+                    } else if(a == unsigned(first)) {
+                        first = boost::contract::virtual_::no_action;
+                    }
+                }
+                if(!actions) return false;
+                if(first == boost::contract::virtual_::no_action) {
+                    // Only one other action (first skipped) in practice.
+                    for(unsigned a = 0; !first; ++a) {
+                        if(actions & (1u << a)) {
+                            first = boost::contract::virtual_::action_enum(a);
+                        }
+                    }
+                }
+                #ifndef BOOST_CONTRACT_NO_OLDS
+                    std::size_t old_inits = me_.v_->old_init_copies_.size();
+                #endif
+                me_.v_->action_ = first;
+                me_.v_->actions_ = actions;
+                me_.v_->base_checked_ = false;
+                me_.v_->base_ftors_ = 0;
+                #ifdef BOOST_CONTRACT_TRACE
+                    // Base contract phases nested in this one.
+                    trace_phase tr("subcontract", me_.where(),
+                            typeid(B).name());
+                #endif
                 try {
                     call<B>(BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_INDEXES_OF(
                             Args));
                 } catch(cond_subcontracting_::signal_no_error const&) {
-                    // No error (do not throw).
+                    // Base body skipped, results returned via v_ (no throw).
                 }
+                ftors |= me_.v_->base_ftors_;
+                #ifndef BOOST_CONTRACT_NO_OLDS
+                    if(me_.v_->old_init_copies_.size() != old_inits) {
+                        ftors |= cond_subcontracting_::base_ftors_old_init;
+                    }
+                #endif
+                return me_.v_->base_checked_;
             }
 
         private:
+            template<class B>
+            struct base_index : boost::mpl::distance<
+                typename boost::mpl::begin<overridden_bases>::type,
+                typename boost::mpl::find<overridden_bases, B*>::type
+            > {};
+
             template<
                 class B
                 // Can't use TVARIADIC_COMMA here.
@@ -452,6 +789,8 @@ private:
             }
             
             cond_subcontracting& me_;
+            boost::contract::virtual_::action_enum first_;
+            unsigned short actions_;
         };
     #endif
 
@@ -461,6 +800,16 @@ private:
     #ifndef BOOST_CONTRACT_NO_CONDITIONS
         boost::contract::virtual_* v_;
         bool base_call_;
+        // Own v_ in place (for overriding functions, empty otherwise).
+        boost::aligned_storage<
+            boost::mpl::empty<overridden_bases>::value ?
+                    1 : sizeof(boost::contract::virtual_),
+            boost::mpl::empty<overridden_bases>::value ?
+                    1 : boost::alignment_of<boost::contract::virtual_>::value
+        > own_v_;
+        // Functors of each base contract (known after its first base call).
+        unsigned char base_ftors_[
+                boost::mpl::size<overridden_bases>::value + 1];
         BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_Z(1,
                 BOOST_CONTRACT_MAX_ARGS, Args, &, args_)
     #endif
@@ -0,0 +1,205 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_COND_TYPED_HPP_
+#define BOOST_CONTRACT_DETAIL_COND_TYPED_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Statically typed counterpart of cond_post<none> + function (for non-member,
+// private, and protected functions). No base class, no virtual functions, and
+// no type erasure (functor types are template params), so the compiler can
+// inline all checks. Entry checks (pre and old) are run as soon as they are
+// specified (they always come first in the chain), so only exit functors
+// (post and except) are stored (and moved along the chain).
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/none.hpp>
+#ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+    #include <boost/contract/detail/checking.hpp>
+#endif
+#include <boost/contract/detail/next_contract.hpp>
+#include <boost/contract/detail/check_cost.hpp>
+#include <boost/contract/scoped_policy.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/config.hpp>
+#include <exception>
+
+namespace boost { namespace contract { namespace detail {
+
+// Exit functors actually stored (none if disabled, so no storage and no call).
+#ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+    template<typename F>
+    struct cond_typed_post {
+        typedef F type;
+        static F const& value(F const& f) { return f; }
+    };
+#else
+    template<typename F>
+    struct cond_typed_post {
+        typedef none type;
+        static none value(F const&) { return none(); }
+    };
+#endif
+
+#ifndef BOOST_CONTRACT_NO_EXCEPTS
+    template<typename F>
+    struct cond_typed_except {
+        typedef F type;
+        static F const& value(F const& f) { return f; }
+    };
+#else
+    template<typename F>
+    struct cond_typed_except {
+        typedef none type;
+        static none value(F const&) { return none(); }
+    };
+#endif
+
+class cond_typed_entry { // Copyable (just failed flag, cost, and policy).
+public:
+    // Sampled out contract skips all checks as failed one (but no handler).
+    explicit cond_typed_entry() : failed_(false), cost_(0),
+            unchecked_(thread_policy::ref().unchecked) {
+        next_contract const next = next_contract::consume();
+        failed_ = next.sampled_out;
+        cost_ = next.cost;
+        if(unchecked_ == boost::contract::checked_all) failed_ = true;
+    }
+
+    template<typename F>
+    void check_pre(F const& f) {
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(checking::already()) return;
+            #endif
+            if(failed_ || !checks(boost::contract::checked_preconditions)) {
+                return;
+            }
+            #if !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
+                !defined(BOOST_CONTRACT_PRECONDITIONS_DISABLE_NO_ASSERTION)
+                checking k;
+            #endif
+            metering m(cost_);
+            try { f(); }
+            catch(...) {
+                failed_ = true;
+                boost::contract::precondition_failure(
+                        boost::contract::from_function);
+            }
+        #endif
+    }
+
+    template<typename F>
+    void copy_old(F const& f) {
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(checking::already()) return;
+            #endif
+            if(failed_) return;
+            if(!checks(boost::contract::checked_postconditions) &&
+                    !checks(boost::contract::checked_excepts)) return;
+            metering m(cost_);
+            try { f(); }
+            catch(...) {
+                failed_ = true;
+                boost::contract::old_failure(boost::contract::from_function);
+            }
+        #endif
+    }
+
+    bool failed() const { return failed_; }
+
+    check_cost* cost() const { return cost_; }
+
+    unsigned unchecked() const { return unchecked_; }
+
+    bool checks(boost::contract::checked_conditions c) const {
+        return !(unchecked_ & c);
+    }
+
+private:
+    bool failed_;
+    check_cost* cost_;
+    unsigned unchecked_; // Conditions not checked (see scoped_policy).
+};
+
+template<typename Post, typename Except>
+class cond_typed { // Movable (only last object in the chain checks on exit).
+    BOOST_MOVABLE_BUT_NOT_COPYABLE(cond_typed)
+
+public:
+    explicit cond_typed(cond_typed_entry const& entry, Post const& post,
+            Except const& except) :
+        owner_(true), failed_(entry.failed()), cost_(entry.cost()),
+        unchecked_(entry.unchecked()), post_(post), except_(except)
+    {}
+
+    // Take over other's post (and exit check) adding except (after post).
+    explicit cond_typed(BOOST_RV_REF_2_TEMPL_ARGS(cond_typed, Post, none)
+            other, Except const& except) :
+        owner_(other.owner_), failed_(other.failed_), cost_(other.cost_),
+        unchecked_(other.unchecked_), post_(boost::move(other.post_)),
+        except_(except)
+    {
+        other.owner_ = false;
+    }
+
+    cond_typed(BOOST_RV_REF(cond_typed) other) : owner_(other.owner_),
+            failed_(other.failed_), cost_(other.cost_),
+            unchecked_(other.unchecked_), post_(boost::move(other.post_)),
+            except_(boost::move(other.except_)) {
+        other.owner_ = false; // Moved-from never checks.
+    }
+
+    ~cond_typed() BOOST_NOEXCEPT_IF(false) {
+        if(!owner_ || failed_) return;
+        #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+            if(checking::already()) return;
+            checking k;
+        #endif
+        metering m(cost_);
+        if(std::uncaught_exception()) {
+            #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                if(unchecked_ & boost::contract::checked_excepts) return;
+                try { call(except_); }
+                catch(...) {
+                    boost::contract::except_failure(
+                            boost::contract::from_function);
+                }
+            #endif
+        } else {
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                if(unchecked_ & boost::contract::checked_postconditions) return;
+                try { call(post_); }
+                catch(...) {
+                    boost::contract::postcondition_failure(
+                            boost::contract::from_function);
+                }
+            #endif
+        }
+    }
+
+private:
+    template<typename F>
+    static void call(F const& f) { f(); }
+    static void call(none const&) {} // No ftor specified (nothing to call).
+
+    template<typename P, typename E>
+    friend class cond_typed;
+
+    bool owner_;
+    bool failed_;
+    check_cost* cost_;
+    unsigned unchecked_;
+    Post post_;
+    Except except_;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,21 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_CONTRACT_SITE_HPP_
+#define BOOST_CONTRACT_DETAIL_CONTRACT_SITE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+
+/* PUBLIC */
+
+// Contracts identified by their sites (see boost::contract::sample).
+#if     defined(BOOST_CONTRACT_METRICS) || defined(BOOST_CONTRACT_PROBES) || \
+        defined(BOOST_CONTRACT_TRACE) || defined(BOOST_CONTRACT_OBSERVER)
+    #define BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+#endif
+
+#endif // #include guard
+
@@ -0,0 +1,209 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINE_FTOR_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINE_FTOR_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/operator_safe_bool.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/and.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+#include <cstring>
+#include <new>
+
+namespace boost { namespace contract { namespace detail {
+
+// Type-erased functor (for lambdas, binds, etc.) held in place if it fits
+// BOOST_CONTRACT_FUNCTOR_BUFFER_SIZE, otherwise on heap. Unlike Boost.Function,
+// functor calls go through one plain func ptr and trivial functors (e.g.,
+// lambdas capturing by reference) are moved with no manager call at all.
+template<typename Sig>
+class inline_ftor; // Only `void ()` and `void (A)` needed by this lib.
+
+class inline_ftor_base : // Non-copyable (but movable via move below).
+    private boost::noncopyable
+{
+protected:
+    inline_ftor_base() : manage_(0) {}
+
+    ~inline_ftor_base() { reset(); }
+
+    template<typename F>
+    void construct(F const& f) { construct(f, fits<F>()); }
+
+    // Move other's functor into this (and leave other owning no functor).
+    void move(inline_ftor_base& other) {
+        reset();
+        if(other.manage_) other.manage_(move_op, other, this);
+        else std::memcpy(buffer_.address(), other.buffer_.address(),
+                buffer_type::size); // Trivial (or no) functor.
+        manage_ = other.manage_;
+        other.manage_ = 0;
+    }
+
+    void reset() {
+        if(manage_) manage_(destroy_op, *this, 0);
+        manage_ = 0;
+    }
+
+    template<typename F>
+    static F& get(inline_ftor_base& me) { return get<F>(me, fits<F>()); }
+
+private:
+    typedef boost::aligned_storage<BOOST_CONTRACT_FUNCTOR_BUFFER_SIZE,
+            boost::alignment_of<boost::detail::max_align>::value> buffer_type;
+    BOOST_STATIC_ASSERT_MSG(buffer_type::size >= sizeof(void*),
+            "functor buffer must at least hold a pointer");
+
+    template<typename F>
+    struct fits : boost::mpl::bool_<
+        sizeof(F) <= buffer_type::size &&
+        boost::alignment_of<F>::value <= buffer_type::alignment
+    > {};
+
+    template<typename F>
+    struct trivial : boost::mpl::and_<
+        fits<F>,
+        boost::has_trivial_copy<F>,
+        boost::has_trivial_destructor<F>
+    > {};
+
+    enum op_enum { move_op, destroy_op };
+
+    template<typename F>
+    void construct(F const& f, boost::mpl::true_ /* fits */) {
+        ::new(buffer_.address()) F(f);
+        manage_ = 0; // No manager needed to move or destroy trivial functors.
+        if(!trivial<F>::value) manage_ = &manage<F>;
+    }
+
+    template<typename F>
+    void construct(F const& f, boost::mpl::false_ /* fits */) {
+        *static_cast<F**>(buffer_.address()) = new F(f);
+        manage_ = &manage<F>;
+    }
+
+    template<typename F>
+    static F& get(inline_ftor_base& me, boost::mpl::true_ /* fits */) {
+        return *static_cast<F*>(me.buffer_.address());
+    }
+
+    template<typename F>
+    static F& get(inline_ftor_base& me, boost::mpl::false_ /* fits */) {
+        return **static_cast<F**>(me.buffer_.address());
+    }
+
+    template<typename F>
+    static void manage(op_enum op, inline_ftor_base& me, inline_ftor_base* to) {
+        manage_fits<F>(op, me, to, fits<F>());
+    }
+
+    template<typename F>
+    static void manage_fits(op_enum op, inline_ftor_base& me,
+            inline_ftor_base* to, boost::mpl::true_ /* fits */) {
+        F& f = get<F>(me);
+        if(op == move_op) ::new(to->buffer_.address()) F(boost::move(f));
+        f.~F();
+    }
+
+    template<typename F>
+    static void manage_fits(op_enum op, inline_ftor_base& me,
+            inline_ftor_base* to, boost::mpl::false_ /* fits */) {
+        F** f = static_cast<F**>(me.buffer_.address());
+        if(op == move_op) *static_cast<F**>(to->buffer_.address()) = *f;
+        else delete *f;
+    }
+
+    buffer_type buffer_;
+    void (*manage_)(op_enum, inline_ftor_base&, inline_ftor_base*);
+};
+
+// NOTE: Null function pointers are handled as no functor (as Boost.Function).
+template<typename F> bool inline_ftor_null(F const&) { return false; }
+template<typename F> bool inline_ftor_null(F* const& f) { return !f; }
+
+template<>
+class inline_ftor<void ()> : public inline_ftor_base {
+public:
+    inline_ftor() : invoke_(0) {}
+
+    template<typename F>
+    inline_ftor& operator=(F const& f) {
+        typedef typename boost::decay<F>::type ftor_type;
+        this->reset();
+        invoke_ = 0;
+        if(!inline_ftor_null(f)) {
+            this->construct<ftor_type>(f);
+            invoke_ = &invoke<ftor_type>;
+        }
+        return *this;
+    }
+
+    void move(inline_ftor& other) {
+        inline_ftor_base::move(other);
+        invoke_ = other.invoke_;
+        other.invoke_ = 0;
+    }
+
+    void operator()() const { invoke_(const_cast<inline_ftor&>(*this)); }
+
+    BOOST_CONTRACT_DETAIL_OPERATOR_SAFE_BOOL(inline_ftor, !!invoke_)
+
+private:
+    template<typename F>
+    static void invoke(inline_ftor_base& me) { get<F>(me)(); }
+
+    void (*invoke_)(inline_ftor_base&);
+};
+
+template<typename A>
+class inline_ftor<void (A)> : public inline_ftor_base {
+public:
+    inline_ftor() : invoke_(0) {}
+
+    template<typename F>
+    inline_ftor& operator=(F const& f) {
+        typedef typename boost::decay<F>::type ftor_type;
+        this->reset();
+        invoke_ = 0;
+        if(!inline_ftor_null(f)) {
+            this->template construct<ftor_type>(f);
+            invoke_ = &invoke<ftor_type>;
+        }
+        return *this;
+    }
+
+    void move(inline_ftor& other) {
+        inline_ftor_base::move(other);
+        invoke_ = other.invoke_;
+        other.invoke_ = 0;
+    }
+
+    void operator()(A a) const { invoke_(const_cast<inline_ftor&>(*this), a); }
+
+    BOOST_CONTRACT_DETAIL_OPERATOR_SAFE_BOOL(inline_ftor, !!invoke_)
+
+private:
+    template<typename F>
+    static void invoke(inline_ftor_base& me, A a) { get<F>(me)(a); }
+
+    void (*invoke_)(inline_ftor_base&, A);
+};
+
+} } } // namespace
+
+#endif // #include guard
+
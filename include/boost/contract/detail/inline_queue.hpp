@@ -0,0 +1,70 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINE_QUEUE_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINE_QUEUE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/detail/debug.hpp>
+#include <boost/noncopyable.hpp>
+#include <deque>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace detail {
+
+// FIFO queue holding up to N elements in place (ring buffer), and more elements
+// in a heap deque allocated only on overflow (so N can be tuned by users).
+// Elements in the ring are always older than elements in the overflow deque.
+template<typename T, std::size_t N>
+class inline_queue : // Non-copyable (held by non-copyable virtual_).
+    private boost::noncopyable
+{
+public:
+    inline_queue() : first_(0), size_(0), more_(0) {}
+
+    ~inline_queue() { delete more_; }
+
+    bool empty() const { return size_ == 0 && (!more_ || more_->empty()); }
+
+    std::size_t size() const { return size_ + (more_ ? more_->size() : 0); }
+
+    void push(T const& value) {
+        if(size_ < N && (!more_ || more_->empty())) {
+            std::size_t last = first_ + size_;
+            if(last >= N) last -= N;
+            slots_[last] = value;
+            ++size_;
+        } else {
+            if(!more_) more_ = new std::deque<T>();
+            more_->push_back(value);
+        }
+    }
+
+    T& front() {
+        BOOST_CONTRACT_DETAIL_DEBUG(!empty());
+        if(size_ > 0) return slots_[first_];
+        return more_->front();
+    }
+
+    void pop() {
+        BOOST_CONTRACT_DETAIL_DEBUG(!empty());
+        if(size_ > 0) {
+            slots_[first_] = T(); // Release element now (as std::queue).
+            if(++first_ == N) first_ = 0;
+            --size_;
+        } else more_->pop_front();
+    }
+
+private:
+    T slots_[N > 0 ? N : 1];
+    std::size_t first_;
+    std::size_t size_;
+    std::deque<T>* more_;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -9,7 +9,12 @@
 
 #include <boost/contract/detail/inlined/old.hpp>
 #include <boost/contract/detail/inlined/core/exception.hpp>
-#include <boost/contract/detail/inlined/detail/checking.hpp>
+#include <boost/contract/detail/inlined/core/assertion_level.hpp>
+#include <boost/contract/detail/inlined/core/check_depth.hpp>
+#include <boost/contract/detail/inlined/site.hpp>
+#include <boost/contract/detail/inlined/metrics.hpp>
+#include <boost/contract/detail/inlined/trace.hpp>
+#include <boost/contract/detail/inlined/observer.hpp>
 
 #endif // #include guard
 
@@ -0,0 +1,43 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_ASSERTION_LEVEL_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_ASSERTION_LEVEL_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/assertion_level.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+
+namespace boost { namespace contract {
+
+namespace assertion_level_ {
+    // Constant init (no init guard) and relaxed because level does not
+    // order any other memory access (checking a bit later is fine).
+    // NOTE: HEADER_ONLY is never defined when compiling lib .cpp (so this does
+    // not depend on config).
+    #ifndef BOOST_CONTRACT_HEADER_ONLY
+        boost::atomic<unsigned> data(assertion_level_default);
+    #else
+        inline boost::atomic<unsigned>& level() BOOST_NOEXCEPT_OR_NOTHROW {
+            static boost::atomic<unsigned> data(assertion_level_default);
+            return data;
+        }
+    #endif
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    unsigned set(unsigned l) BOOST_NOEXCEPT_OR_NOTHROW {
+        level().store(l, boost::memory_order_relaxed);
+        return l;
+    }
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,42 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_CHECK_DEPTH_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_CHECK_DEPTH_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/core/check_depth.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+
+namespace boost { namespace contract {
+
+namespace check_depth_ {
+    // Constant init (no init guard) and relaxed because depth does not
+    // order any other memory access (checking a bit later is fine).
+    inline boost::atomic<unsigned>& depth() {
+        static boost::atomic<unsigned> data(0);
+        return data;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    unsigned set(unsigned d) BOOST_NOEXCEPT_OR_NOTHROW {
+        depth().store(d, boost::memory_order_relaxed);
+        return d;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    unsigned get() BOOST_NOEXCEPT_OR_NOTHROW {
+        return depth().load(boost::memory_order_relaxed);
+    }
+}
+
+} } // namespace
+
+#endif // #include guard
+
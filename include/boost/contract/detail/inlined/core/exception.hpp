@@ -11,16 +11,16 @@
 // .cpp does not need recompiling if config changes (recompile only user code).
 
 #include <boost/contract/core/exception.hpp>
-#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/static_local_snapshot.hpp>
 #include <boost/contract/detail/declspec.hpp>
-#include <boost/thread/lock_guard.hpp>
-#include <boost/thread/mutex.hpp>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/config.hpp>
 #include <string>
 #include <sstream>
 #include <iostream>
 #include <exception>
+#include <limits>
+#include <cstddef>
 
 namespace boost { namespace contract {
 
@@ -58,12 +58,83 @@ assertion_failure::assertion_failure(char const* const code) :
     file_(""), line_(0), code_(code)
 { init(); }
 
+BOOST_CONTRACT_DETAIL_DECLINLINE
+assertion_failure::assertion_failure(assertion_failure const& other) :
+    std::exception(other), boost::contract::exception(other),
+    file_(other.file_), line_(other.line_), code_(other.code_)
+{ init(); }
+
+BOOST_CONTRACT_DETAIL_DECLINLINE
+assertion_failure& assertion_failure::operator=(assertion_failure const& other)
+{
+    std::exception::operator=(other);
+    boost::contract::exception::operator=(other);
+    file_ = other.file_;
+    line_ = other.line_;
+    code_ = other.code_;
+    init();
+    return *this;
+}
+
 BOOST_CONTRACT_DETAIL_DECLINLINE
 assertion_failure::~assertion_failure() BOOST_NOEXCEPT_OR_NOTHROW {}
 
+namespace exception_ {
+    // Append to fixed-size buffer (updating end) truncating with "..." if full.
+    class what_buffer {
+    public:
+        what_buffer(char* begin, std::size_t size) :
+                end_(begin), last_(begin + size - 1) {}
+
+        ~what_buffer() { *end_ = '\0'; }
+
+        what_buffer& operator<<(char const* str) {
+            for(; *str != '\0'; ++str) {
+                if(end_ == last_) {
+                    for(int i = 1; i <= 3; ++i) *(end_ - i) = '.';
+                    return *this;
+                }
+                *end_++ = *str;
+            }
+            return *this;
+        }
+
+        what_buffer& operator<<(unsigned long num) {
+            char digits[std::numeric_limits<unsigned long>::digits10 + 2];
+            char* d = digits + sizeof digits - 1;
+            *d = '\0';
+            do { *--d = static_cast<char>('0' + num % 10); } while(num /= 10);
+            return *this << static_cast<char const*>(d);
+        }
+
+    private:
+        char* end_;
+        char* const last_;
+    };
+}
+
 BOOST_CONTRACT_DETAIL_DECLINLINE
 char const* assertion_failure::what() const BOOST_NOEXCEPT_OR_NOTHROW {
-    return what_.c_str();
+    if(formatting_.load(boost::memory_order_acquire) == formatted) {
+        return what_;
+    }
+    unsigned char expected = unformatted;
+    if(formatting_.compare_exchange_strong(expected, formatting_what,
+            boost::memory_order_acquire)) {
+        exception_::what_buffer text(what_, sizeof what_);
+        text << "assertion";
+        if(*code_ != '\0') text << " \"" << code_ << "\"";
+        text << " failed";
+        if(*file_ != '\0') {
+            text << ": file \"" << file_ << "\"";
+            if(line_ != 0) text << ", line " << line_;
+        }
+        formatting_.store(formatted, boost::memory_order_release);
+    } else {
+        // Another thread formatting (short and bounded, so just wait).
+        while(formatting_.load(boost::memory_order_acquire) != formatted) {}
+    }
+    return what_;
 }
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
@@ -77,15 +148,10 @@ char const* assertion_failure::code() const { return code_; }
 
 BOOST_CONTRACT_DETAIL_DECLINLINE
 void assertion_failure::init() {
-    std::ostringstream text;
-    text << "assertion";
-    if(std::string(code_) != "") text << " \"" << code_ << "\"";
-    text << " failed";
-    if(std::string(file_) != "") {
-        text << ": file \"" << file_ << "\"";
-        if(line_ != 0) text << ", line " << line_;
-    }
-    what_ = text.str();
+    if(!file_) file_ = "";
+    if(!code_) code_ = "";
+    what_[0] = '\0';
+    formatting_.store(unformatted, boost::memory_order_relaxed); // By what().
 }
 
 namespace exception_ {
@@ -126,14 +192,15 @@ namespace exception_ {
     template<failure_key Key>
     void default_from_handler(from) { default_handler<Key>(); }
 
-    // Check failure.
+    // NOTE: Handlers are lock-free snapshots (so not serialized while they
+    // run), so ..._locked functions no longer lock and just call ..._unlocked
+    // (both kept because they are exported by this lib and called by user code
+    // depending on BOOST_CONTRACT_DISABLE_THREADS).
 
-    struct check_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<check_failure_mutex_tag,
-            boost::mutex> check_failure_mutex;
+    // Check failure.
 
     struct check_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         check_failure_handler_tag,
         failure_handler, 
         void (*)(),
@@ -143,47 +210,40 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     failure_handler const& set_check_failure_unlocked(failure_handler const& f)
             BOOST_NOEXCEPT_OR_NOTHROW {
-        check_failure_handler::ref() = f;
+        check_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     failure_handler const& set_check_failure_locked(failure_handler const& f)
             BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(check_failure_mutex::ref());
         return set_check_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     failure_handler get_check_failure_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
-        return check_failure_handler::ref();
+        return check_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     failure_handler get_check_failure_locked() BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(check_failure_mutex::ref());
         return get_check_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void check_failure_unlocked() /* can throw */ {
-        check_failure_handler::ref()();
+        check_failure_handler::call();
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void check_failure_locked() /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(check_failure_mutex::ref());
         check_failure_unlocked();
     }
     
     // Precondition failure.
 
-    struct pre_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<pre_failure_mutex_tag,
-            boost::mutex> pre_failure_mutex;
-
     struct pre_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         pre_failure_handler_tag,
         from_failure_handler,
         void (*)(from),
@@ -193,47 +253,40 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_pre_failure_unlocked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        pre_failure_handler::ref() = f;
+        pre_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_pre_failure_locked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(pre_failure_mutex::ref());
         return set_pre_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_pre_failure_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
-        return pre_failure_handler::ref();
+        return pre_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_pre_failure_locked() BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(pre_failure_mutex::ref());
         return get_pre_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void pre_failure_unlocked(from where) /* can throw */ {
-        pre_failure_handler::ref()(where);
+        pre_failure_handler::call(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void pre_failure_locked(from where) /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(pre_failure_mutex::ref());
         pre_failure_unlocked(where);
     }
     
     // Postcondition failure.
 
-    struct post_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<post_failure_mutex_tag,
-            boost::mutex> post_failure_mutex;
-
     struct post_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         post_failure_handler_tag,
         from_failure_handler,
         void (*)(from),
@@ -243,47 +296,40 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_post_failure_unlocked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        post_failure_handler::ref() = f;
+        post_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_post_failure_locked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(post_failure_mutex::ref());
         return set_post_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_post_failure_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
-        return post_failure_handler::ref();
+        return post_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_post_failure_locked() BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(post_failure_mutex::ref());
         return get_post_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void post_failure_unlocked(from where) /* can throw */ {
-        post_failure_handler::ref()(where);
+        post_failure_handler::call(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void post_failure_locked(from where) /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(post_failure_mutex::ref());
         post_failure_unlocked(where);
     }
     
     // Except failure.
 
-    struct except_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<except_failure_mutex_tag,
-            boost::mutex> except_failure_mutex;
-
     struct except_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         except_failure_handler_tag,
         from_failure_handler,
         void (*)(from),
@@ -293,48 +339,41 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_except_failure_unlocked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        except_failure_handler::ref() = f;
+        except_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_except_failure_locked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(except_failure_mutex::ref());
         return set_except_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_except_failure_unlocked()
             BOOST_NOEXCEPT_OR_NOTHROW {
-        return except_failure_handler::ref();
+        return except_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_except_failure_locked() BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(except_failure_mutex::ref());
         return get_except_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void except_failure_unlocked(from where) /* can throw */ {
-        except_failure_handler::ref()(where);
+        except_failure_handler::call(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void except_failure_locked(from where) /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(except_failure_mutex::ref());
         except_failure_unlocked(where);
     }
 
     // Old-copy failure.
 
-    struct old_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<old_failure_mutex_tag,
-            boost::mutex> old_failure_mutex;
-
     struct old_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         old_failure_handler_tag,
         from_failure_handler,
         void (*)(from),
@@ -344,47 +383,40 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_old_failure_unlocked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        old_failure_handler::ref() = f;
+        old_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_old_failure_locked(from_failure_handler
             const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(old_failure_mutex::ref());
         return set_old_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_old_failure_unlocked() BOOST_NOEXCEPT_OR_NOTHROW {
-        return old_failure_handler::ref();
+        return old_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_old_failure_locked() BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(old_failure_mutex::ref());
         return get_old_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void old_failure_unlocked(from where) /* can throw */ {
-        old_failure_handler::ref()(where);
+        old_failure_handler::call(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void old_failure_locked(from where) /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(old_failure_mutex::ref());
         old_failure_unlocked(where);
     }
     
     // Entry invariant failure.
 
-    struct entry_inv_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<
-            entry_inv_failure_mutex_tag, boost::mutex> entry_inv_failure_mutex;
-
     struct entry_inv_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         entry_inv_failure_handler_tag,
         from_failure_handler,
         void (*)(from),
@@ -394,49 +426,42 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_entry_inv_failure_unlocked(
             from_failure_handler const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        entry_inv_failure_handler::ref() = f;
+        entry_inv_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_entry_inv_failure_locked(
             from_failure_handler const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(entry_inv_failure_mutex::ref());
         return set_entry_inv_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_entry_inv_failure_unlocked()
             BOOST_NOEXCEPT_OR_NOTHROW {
-        return entry_inv_failure_handler::ref();
+        return entry_inv_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_entry_inv_failure_locked()
             BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(entry_inv_failure_mutex::ref());
         return get_entry_inv_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void entry_inv_failure_unlocked(from where) /* can throw */ {
-        entry_inv_failure_handler::ref()(where);
+        entry_inv_failure_handler::call(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void entry_inv_failure_locked(from where) /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(entry_inv_failure_mutex::ref());
         entry_inv_failure_unlocked(where);
     }
     
     // Exit invariant failure.
 
-    struct exit_inv_failure_mutex_tag;
-    typedef boost::contract::detail::static_local_var<
-            exit_inv_failure_mutex_tag, boost::mutex> exit_inv_failure_mutex;
-
     struct exit_inv_failure_handler_tag;
-    typedef boost::contract::detail::static_local_var_init<
+    typedef boost::contract::detail::static_local_snapshot<
         exit_inv_failure_handler_tag,
         from_failure_handler,
         void (*)(from),
@@ -446,38 +471,35 @@ namespace exception_ {
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_exit_inv_failure_unlocked(
             from_failure_handler const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        exit_inv_failure_handler::ref() = f;
+        exit_inv_failure_handler::set(f);
         return f;
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler const& set_exit_inv_failure_locked(
             from_failure_handler const& f) BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(exit_inv_failure_mutex::ref());
         return set_exit_inv_failure_unlocked(f);
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_exit_inv_failure_unlocked()
             BOOST_NOEXCEPT_OR_NOTHROW {
-        return exit_inv_failure_handler::ref();
+        return exit_inv_failure_handler::get();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     from_failure_handler get_exit_inv_failure_locked()
             BOOST_NOEXCEPT_OR_NOTHROW {
-        boost::lock_guard<boost::mutex> lock(exit_inv_failure_mutex::ref());
         return get_exit_inv_failure_unlocked();
     }
 
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void exit_inv_failure_unlocked(from where) /* can throw */ {
-        exit_inv_failure_handler::ref()(where);
+        exit_inv_failure_handler::call(where);
     }
     
     BOOST_CONTRACT_DETAIL_DECLINLINE
     void exit_inv_failure_locked(from where) /* can throw */ {
-        boost::lock_guard<boost::mutex> lock(exit_inv_failure_mutex::ref());
         exit_inv_failure_unlocked(where);
     }
 }
@@ -0,0 +1,32 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_METRICS_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_METRICS_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/detail/metrics.hpp>
+#include <boost/contract/detail/list_head.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+
+namespace boost { namespace contract {
+
+namespace metrics_ {
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::atomic<boost::contract::detail::metrics_block*>& head()
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        return boost::contract::detail::list_head<
+                boost::contract::detail::metrics_block>::ref();
+    }
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,39 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_OBSERVER_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_OBSERVER_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/observer.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost { namespace contract {
+
+namespace observer_ {
+    // Constant init (integer atomic, so no init order issue and no init guard
+    // when loaded at each phase).
+    // NOTE: HEADER_ONLY is never defined when compiling lib .cpp (so this does
+    // not depend on config).
+    #ifndef BOOST_CONTRACT_HEADER_ONLY
+        boost::atomic<boost::uintptr_t> data(0);
+    #else
+        inline boost::atomic<boost::uintptr_t>& get()
+                BOOST_NOEXCEPT_OR_NOTHROW {
+            static boost::atomic<boost::uintptr_t> data(0);
+            return data;
+        }
+    #endif
+}
+
+} } // namespace
+
+#endif // #include guard
+
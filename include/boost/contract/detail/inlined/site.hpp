@@ -0,0 +1,164 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_SITE_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_SITE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/site.hpp>
+#include <boost/contract/detail/static_key.hpp>
+#include <boost/contract/detail/list_head.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#ifdef BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <cstring>
+    #include <new>
+#endif
+
+namespace boost { namespace contract {
+
+namespace site_ {
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::atomic<site*>& head() BOOST_NOEXCEPT_OR_NOTHROW {
+        return boost::contract::detail::list_head<site>::ref();
+    }
+
+    #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM
+        struct jumps {
+            boost::contract::detail::static_key_jump const* begin;
+            boost::contract::detail::static_key_jump const* end;
+            jumps* next;
+        };
+
+        // Guarded by lock (so only accessed when adding modules and enabling
+        // or disabling sites, never when checking sites).
+        inline jumps*& jumps_head() {
+            static jumps* data = 0;
+            return data;
+        }
+
+        // Spin lock (constant init, and patching is rare and quick).
+        class jumps_lock {
+        public:
+            jumps_lock() {
+                while(locked().exchange(true, boost::memory_order_acquire)) {}
+            }
+            ~jumps_lock() {
+                locked().store(false, boost::memory_order_release);
+            }
+
+        private:
+            static boost::atomic<bool>& locked() {
+                static boost::atomic<bool> data(false);
+                return data;
+            }
+        };
+
+        // Write NOP or jump to target at a jump site (using single atomic
+        // store, because other threads might be executing this code).
+        inline void write_jump(boost::contract::detail::static_key_jump const&
+                j, bool jump) {
+            #if defined(__x86_64__)
+                unsigned char ins[5] = {0x0f, 0x1f, 0x44, 0x00, 0x00}; // NOP.
+                if(jump) { // JMP rel32.
+                    boost::int32_t const rel = static_cast<boost::int32_t>(
+                        static_cast<boost::int64_t>(j.target - (j.code + 5)));
+                    ins[0] = 0xe9;
+                    std::memcpy(ins + 1, &rel, sizeof rel);
+                }
+                // Aligned by BOOST_CONTRACT_DETAIL_STATIC_KEY_JMP_.
+                boost::uint64_t* const word =
+                        reinterpret_cast<boost::uint64_t*>(j.code);
+                boost::uint64_t value = __atomic_load_n(word, __ATOMIC_RELAXED);
+                boost::uint64_t const old = value;
+                std::memcpy(&value, ins, sizeof ins);
+            #else // __aarch64__
+                boost::uint32_t value = 0xd503201f; // NOP.
+                if(jump) { // B imm26.
+                    value = 0x14000000 | (static_cast<boost::uint32_t>(
+                        (static_cast<boost::int64_t>(j.target - j.code)) >> 2) &
+                        0x03ffffff);
+                }
+                boost::uint32_t* const word =
+                        reinterpret_cast<boost::uint32_t*>(j.code);
+                boost::uint32_t const old = __atomic_load_n(word,
+                        __ATOMIC_RELAXED);
+            #endif
+            if(value == old) return; // Already patched.
+
+            // Word aligned so never across pages.
+            boost::uint64_t const page_size = sysconf(_SC_PAGESIZE);
+            void* const page =
+                    reinterpret_cast<void*>(j.code & ~(page_size - 1));
+            if(mprotect(page, page_size, PROT_READ | PROT_WRITE | PROT_EXEC)) {
+                // Cannot patch (e.g., W^X). At start-up, code left as compiled
+                // to jump where site state is checked (see STATIC_KEY_JUMP).
+                // Later, code patched at start-up might be left stale instead
+                // (not expected, as same pages were writable at start-up).
+                return;
+            }
+            __atomic_store_n(word, value, __ATOMIC_SEQ_CST);
+            __builtin___clear_cache(reinterpret_cast<char*>(word),
+                    reinterpret_cast<char*>(word + 1));
+            mprotect(page, page_size, PROT_READ | PROT_EXEC);
+        }
+
+        inline site const* jump_key(
+                boost::contract::detail::static_key_jump const& j) {
+            return reinterpret_cast<site const*>(j.key);
+        }
+    #endif
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void add_jumps(boost::contract::detail::static_key_jump const* begin,
+            boost::contract::detail::static_key_jump const* end)
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM
+            if(!begin || begin == end) return;
+            jumps_lock lock;
+            for(jumps* js = jumps_head(); js; js = js->next) {
+                if(js->begin == begin) return; // Already added by other TU.
+            }
+            jumps* js = new (std::nothrow) jumps;
+            if(!js) return;
+            js->begin = begin;
+            js->end = end;
+            js->next = jumps_head();
+            jumps_head() = js;
+            for(boost::contract::detail::static_key_jump const* j = begin;
+                    j != end; ++j) {
+                // List all sites of module (also if not reached yet), and patch
+                // them from compiled jump to NOP or jump per their state.
+                write_jump(*j, jump_key(*j)->enabled());
+            }
+        #endif
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    void patch(site const* s) BOOST_NOEXCEPT_OR_NOTHROW {
+        #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM
+            jumps_lock lock;
+            if(!jumps_head()) return; // No jump site.
+            bool const jump = s->enabled(); // Under lock so latest state.
+            for(jumps* js = jumps_head(); js; js = js->next) {
+                for(boost::contract::detail::static_key_jump const* j =
+                        js->begin; j != js->end; ++j) {
+                    if(jump_key(*j) == s) write_jump(*j, jump);
+                }
+            }
+        #endif
+    }
+}
+
+} } // namespace
+
+#endif // #include guard
+
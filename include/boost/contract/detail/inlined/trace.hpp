@@ -0,0 +1,45 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_INLINED_TRACE_HPP_
+#define BOOST_CONTRACT_DETAIL_INLINED_TRACE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Do NOT use config macros BOOST_CONTRACT_... in this file so lib
+// .cpp does not need recompiling if config changes (recompile only user code).
+
+#include <boost/contract/detail/trace.hpp>
+#include <boost/contract/detail/list_head.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <cstddef>
+
+namespace boost { namespace contract {
+
+namespace trace_ {
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::atomic<boost::contract::detail::trace_buffer*>& head()
+            BOOST_NOEXCEPT_OR_NOTHROW {
+        return boost::contract::detail::list_head<
+                boost::contract::detail::trace_buffer>::ref();
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::atomic<bool>& on() BOOST_NOEXCEPT_OR_NOTHROW {
+        static boost::atomic<bool> data(false);
+        return data;
+    }
+
+    BOOST_CONTRACT_DETAIL_DECLINLINE
+    boost::atomic<std::size_t>& buffer_size() BOOST_NOEXCEPT_OR_NOTHROW {
+        static boost::atomic<std::size_t> data(65536);
+        return data;
+    }
+}
+
+} } // namespace
+
+#endif // #include guard
+
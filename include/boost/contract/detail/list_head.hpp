@@ -0,0 +1,33 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_LIST_HEAD_HPP_
+#define BOOST_CONTRACT_DETAIL_LIST_HEAD_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/atomic.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Head of a global list that nodes are added to without lock, and that nodes
+// are never removed from (sites, metrics blocks, and trace buffers).
+// NOTE: Local static so nodes can be added at any time (also during static
+// init). Atomic pointers might need an init guard, but heads are only used to
+// add nodes (when sites are constructed or when threads first check sites or
+// record events) and to traverse lists (by exporters, etc.), never when just
+// checking contracts. This must only be used from the exported functions of
+// detail/inlined/ files (so there is a single list when this lib is shared).
+template<typename Node>
+struct list_head {
+    static boost::atomic<Node*>& ref() {
+        static boost::atomic<Node*> data(0);
+        return data;
+    }
+};
+
+} } } // namespace
+
+#endif // #include guard
+
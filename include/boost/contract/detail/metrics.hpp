@@ -0,0 +1,289 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_METRICS_HPP_
+#define BOOST_CONTRACT_DETAIL_METRICS_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    #include <chrono>
+#endif
+
+/* PRIVATE */
+
+// Sites cached per thread (set-associative, 2^BITS sets of WAYS sites, misses
+// search list of this thread's blocks).
+#define BOOST_CONTRACT_DETAIL_METRICS_CACHE_BITS_ 6
+#define BOOST_CONTRACT_DETAIL_METRICS_CACHE_WAYS_ 4
+
+/* CODE */
+
+namespace boost { namespace contract {
+
+class site;
+
+namespace detail {
+
+enum metrics_phase {
+    metrics_entry_invariants,
+    metrics_preconditions,
+    metrics_old_values,
+    metrics_exit_invariants,
+    metrics_postconditions,
+    metrics_excepts,
+    metrics_phases
+};
+
+// Phase of failure handler (metrics_phases if no handler).
+inline metrics_phase metrics_failure_phase(void (*h)(boost::contract::from)) {
+    if(h == &boost::contract::entry_invariant_failure) {
+        return metrics_entry_invariants;
+    } else if(h == &boost::contract::precondition_failure) {
+        return metrics_preconditions;
+    } else if(h == &boost::contract::old_failure) {
+        return metrics_old_values;
+    } else if(h == &boost::contract::exit_invariant_failure) {
+        return metrics_exit_invariants;
+    } else if(h == &boost::contract::postcondition_failure) {
+        return metrics_postconditions;
+    } else if(h == &boost::contract::except_failure) {
+        return metrics_excepts;
+    }
+    return metrics_phases;
+}
+
+// Latency buckets (powers of 10 nanoseconds from 100ns, last one unbounded).
+int const metrics_buckets = 8;
+
+inline boost::uint64_t metrics_bound(int bucket) {
+    if(bucket >= metrics_buckets - 1) {
+        return boost::integer_traits<boost::uint64_t>::const_max;
+    }
+    boost::uint64_t b = 100;
+    for(int i = 0; i < bucket; ++i) b *= 10;
+    return b;
+}
+
+// Counters of one site written by one thread (so no RMW and no contention,
+// other threads only read them).
+struct metrics_block : private boost::noncopyable {
+    explicit metrics_block(site const* s, void const* t) : where(s), thread(t),
+            next(0), thread_next(0), calls(0), checks(0), failures(0) {
+        for(int i = 0; i < metrics_phases; ++i) {
+            nanoseconds[i] = 0;
+            for(int j = 0; j < metrics_buckets; ++j) latency[i][j] = 0;
+        }
+    }
+
+    static void add(boost::atomic<boost::uint64_t>& counter,
+            boost::uint64_t value) { // Only called by writer thread.
+        counter.store(counter.load(boost::memory_order_relaxed) + value,
+                boost::memory_order_relaxed);
+    }
+
+    site const* const where;
+    void const* const thread;
+    metrics_block* next; // Set before block published (then const).
+    metrics_block* thread_next; // Next block of writer thread (only it reads).
+    boost::atomic<boost::uint64_t> calls;
+    boost::atomic<boost::uint64_t> checks;
+    boost::atomic<boost::uint64_t> failures;
+    boost::atomic<boost::uint64_t> nanoseconds[metrics_phases];
+    boost::atomic<boost::uint64_t> latency[metrics_phases][metrics_buckets];
+};
+
+} // namespace
+
+/** @cond */
+namespace metrics_ {
+    // List of all blocks (shared by all user code linking to this lib as
+    // shared lib, blocks never removed so they outlive their threads).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    boost::atomic<boost::contract::detail::metrics_block*>& head()
+            BOOST_NOEXCEPT_OR_NOTHROW;
+}
+/** @endcond */
+
+namespace detail {
+
+// Per-thread access to metrics blocks.
+class metrics {
+public:
+    // Block of this thread for site (null if out of memory).
+    static metrics_block* find(site const* s) {
+        blocks& c = cache::ref();
+        // Multiplicative hash (so sites at page strides, etc. do not collide).
+        std::size_t const i = static_cast<std::size_t>((static_cast<
+                boost::uint64_t>(reinterpret_cast<std::size_t>(s)) *
+                0x9E3779B97F4A7C15ull) >>
+                (64 - BOOST_CONTRACT_DETAIL_METRICS_CACHE_BITS_));
+        set& w = c.sets[i];
+        for(int j = 0; j < BOOST_CONTRACT_DETAIL_METRICS_CACHE_WAYS_; ++j) {
+            if(BOOST_LIKELY(w.sites[j] == s)) return w.blocks[j];
+        }
+        metrics_block* b = c.own;
+        while(b && b->where != s) b = b->thread_next;
+        if(!b) b = adopt(s, c);
+        if(!b) return 0; // Not counted (but contract checked).
+        for(int j = BOOST_CONTRACT_DETAIL_METRICS_CACHE_WAYS_ - 1; j > 0; --j) {
+            w.sites[j] = w.sites[j - 1]; // Evict least recently missed.
+            w.blocks[j] = w.blocks[j - 1];
+        }
+        w.sites[0] = s;
+        w.blocks[0] = b;
+        return b;
+    }
+
+    // Block of assertion site being checked by this thread (for failures).
+    static void assertion(metrics_block* b) { assertion_block::ref() = b; }
+
+    static metrics_block* assertion() { return assertion_block::ref(); }
+
+    static boost::uint64_t nanoseconds() {
+        #ifndef BOOST_NO_CXX11_HDR_CHRONO
+            return static_cast<boost::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+                ).count()
+            );
+        #else
+            return 0; // No clock (so only counters, no times).
+        #endif
+    }
+
+private:
+    struct set {
+        site const* sites[BOOST_CONTRACT_DETAIL_METRICS_CACHE_WAYS_];
+        metrics_block* blocks[BOOST_CONTRACT_DETAIL_METRICS_CACHE_WAYS_];
+    };
+
+    struct blocks { // POD (for pre-C++11 thread-local).
+        set sets[1 << BOOST_CONTRACT_DETAIL_METRICS_CACHE_BITS_];
+        metrics_block* own; // List of this thread's blocks.
+    };
+
+    // Only called the first time this thread checks a site.
+    static metrics_block* adopt(site const* s, blocks& c) {
+        metrics_block* b = boost::contract::metrics_::head().load(
+                boost::memory_order_acquire);
+        // Thread address reused by a later thread, that then writes blocks of
+        // ended thread (still single writer).
+        while(b && (b->where != s || b->thread != &c)) b = b->next;
+        if(!b) {
+            try { b = new metrics_block(s, &c); }
+            catch(...) { return 0; }
+            boost::atomic<metrics_block*>& head =
+                    boost::contract::metrics_::head();
+            metrics_block* n = head.load(boost::memory_order_relaxed);
+            do { b->next = n; } while(!head.compare_exchange_weak(n, b,
+                    boost::memory_order_release, boost::memory_order_relaxed));
+        }
+        b->thread_next = c.own;
+        c.own = b;
+        return b;
+    }
+
+    struct cache_tag;
+    struct assertion_block_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<cache_tag, blocks> cache;
+        typedef thread_local_var<assertion_block_tag, metrics_block*>
+                assertion_block;
+    #else
+        typedef static_local_var<cache_tag, blocks> cache;
+        typedef static_local_var<assertion_block_tag, metrics_block*>
+                assertion_block;
+    #endif
+};
+
+// RAII to time a contract phase (if its site has metrics).
+class metrics_timer : private boost::noncopyable {
+public:
+    explicit metrics_timer(metrics_block* b, metrics_phase p) : block_(b),
+            phase_(p), start_(b ? metrics::nanoseconds() : 0) {}
+
+    ~metrics_timer() {
+        if(block_) {
+            boost::uint64_t const elapsed = metrics::nanoseconds() - start_;
+            metrics_block::add(block_->nanoseconds[phase_], elapsed);
+            #ifndef BOOST_NO_CXX11_HDR_CHRONO
+                int b = 0;
+                while(elapsed > metrics_bound(b)) ++b;
+                metrics_block::add(block_->latency[phase_][b], 1);
+            #endif
+        }
+    }
+
+private:
+    metrics_block* const block_;
+    metrics_phase const phase_;
+    boost::uint64_t const start_;
+};
+
+// Block of assertion site (null if out of memory) and if site enabled.
+struct metrics_assertion_site {
+    metrics_block* block;
+    bool enabled;
+};
+
+// Count assertion site reached (and checked if enabled).
+inline metrics_assertion_site metrics_assertion(site const& s, bool enabled) {
+    metrics_assertion_site const a = {metrics::find(&s), enabled};
+    if(a.block) {
+        metrics_block::add(a.block->calls, 1);
+        if(enabled) metrics_block::add(a.block->checks, 1);
+    }
+    return a;
+}
+
+// Temporary of assertion full-expression (so destructed after failure is
+// counted, also if cond throws) that makes its site the one being checked by
+// this thread, restoring the enclosing one (so failures are never counted for
+// assertions nested in cond, e.g., in functions called by cond).
+class metrics_assertion_scope : private boost::noncopyable {
+public:
+    explicit metrics_assertion_scope(metrics_assertion_site const& a) :
+            enclosing_(metrics::assertion()), enabled_(a.enabled) {
+        metrics::assertion(a.block);
+    }
+
+    ~metrics_assertion_scope() { metrics::assertion(enclosing_); }
+
+    bool enabled() const { return enabled_; }
+
+private:
+    metrics_block* const enclosing_;
+    bool const enabled_;
+};
+
+// Count failure of assertion site being checked (returns exception to throw).
+template<typename E>
+E const& metrics_assertion_failed(E const& e) {
+    if(metrics_block* const b = metrics::assertion()) {
+        metrics_block::add(b->failures, 1);
+    }
+    return e;
+}
+
+} } } // namespace
+
+/** @cond */
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/metrics.hpp>
+#endif
+/** @endcond */
+
+#endif // #include guard
+
@@ -0,0 +1,80 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_NESTED_OBJECT_HPP_
+#define BOOST_CONTRACT_DETAIL_NESTED_OBJECT_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/type_traits/is_polymorphic.hpp>
+#include <boost/utility/enable_if.hpp>
+
+/* PRIVATE */
+
+// Deeper nesting of contracted calls just checks invariants of inner calls.
+#define BOOST_CONTRACT_DETAIL_NESTED_OBJECT_MAX_ 16
+
+/* CODE */
+
+namespace boost { namespace contract { namespace detail {
+
+// Objects this thread is currently inside contracted public functions,
+// constructors, or destructors of (see BOOST_CONTRACT_NO_NESTED_INVARIANTS).
+// NOTE: Fixed size stack of plain pointers (POD, so pre-C++11 thread-local
+// and no allocation), searched from top as nested calls are usually on the
+// object of the enclosing call.
+class nested_object {
+public:
+    // Return true if obj already inside a call (push obj if room for it).
+    template<class C>
+    static bool enter(C* obj, bool& pushed) {
+        void const volatile* const key = most_derived(obj);
+        objects& s = stack::ref();
+        bool nested = false;
+        for(unsigned i = s.size; i > 0; --i) {
+            if(s.objs[i - 1] == key) { nested = true; break; }
+        }
+        pushed = s.size < BOOST_CONTRACT_DETAIL_NESTED_OBJECT_MAX_;
+        if(pushed) s.objs[s.size++] = key;
+        return nested;
+    }
+
+    // Pop obj pushed by enter (calls exit in reverse order so LIFO).
+    static void exit() { --stack::ref().size; }
+
+private:
+    // Objects keyed by their most-derived object, so calls via different base
+    // subobjects (multiple inheritance) are on same object (only if C is
+    // polymorphic, non-polymorphic bases cannot be traced back to it).
+    template<class C>
+    static typename boost::enable_if<boost::is_polymorphic<C>,
+            void const volatile*>::type most_derived(C* obj) {
+        return dynamic_cast<void const volatile*>(obj);
+    }
+
+    template<class C>
+    static typename boost::disable_if<boost::is_polymorphic<C>,
+            void const volatile*>::type most_derived(C* obj) {
+        return obj;
+    }
+
+    struct objects {
+        void const volatile* objs[BOOST_CONTRACT_DETAIL_NESTED_OBJECT_MAX_];
+        unsigned size;
+    };
+
+    struct stack_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<stack_tag, objects> stack;
+    #else
+        typedef static_local_var<stack_tag, objects> stack;
+    #endif
+};
+
+} } } // namespace
+
+#endif // #include guard
+
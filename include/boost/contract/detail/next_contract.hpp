@@ -0,0 +1,119 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_NEXT_CONTRACT_HPP_
+#define BOOST_CONTRACT_DETAIL_NEXT_CONTRACT_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace boost { namespace contract {
+
+class site;
+
+namespace detail {
+
+class check_cost;
+
+// State set by boost::contract::sample (and its policy) for the next contract
+// declared by this thread in the same function. It is consumed (i.e., reset)
+// when that contract is initialized, so contracts of functions called by the
+// body are not affected. Contracts of functions called by old value
+// expressions (e.g., `OLDOF(size())`) are declared before that contract but
+// within old_expr, so they do not see nor consume this state.
+// NOTE: POD zero-initialized to no state (so just inlined thread-local reads).
+struct next_contract {
+    bool set;
+    bool sampled_out; // Not checked at all (old values not copied either).
+    check_cost* cost; // Measure checking cost (null if not).
+    site const* where; // Null unless site given.
+    unsigned old_exprs; // Nested old value expressions when set.
+
+    static next_contract& ref() { return data::ref(); }
+
+    // Only state set in same function (not in one calling old value expr).
+    static next_contract const* owned() {
+        next_contract const& n = data::ref();
+        return n.set && n.old_exprs == old_exprs_ref() ? &n : 0;
+    }
+
+    static bool sampled_out_owned() {
+        next_contract const* const n = owned();
+        return n && n->sampled_out;
+    }
+
+    static next_contract consume() {
+        next_contract n = next_contract();
+        if(owned()) {
+            n = data::ref();
+            data::ref().set = false;
+        }
+        return n;
+    }
+
+private:
+    friend class next_contract_scope;
+    friend class old_expr;
+
+    struct data_tag;
+    struct old_exprs_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<data_tag, next_contract> data;
+        typedef thread_local_var_init<old_exprs_tag, unsigned, unsigned, 0>
+                old_exprs_var;
+    #else
+        typedef static_local_var<data_tag, next_contract> data;
+        typedef static_local_var_init<old_exprs_tag, unsigned, unsigned, 0>
+                old_exprs_var;
+    #endif
+
+    static unsigned& old_exprs_ref() { return old_exprs_var::ref(); }
+};
+
+// RAII to set state for next contract, and restore state of calling function
+// at end of scope (in case this function is called by an old value expr).
+class next_contract_scope : private boost::noncopyable {
+public:
+    explicit next_contract_scope() : prior_(next_contract::ref()) {
+        next_contract& n = next_contract::ref();
+        n = next_contract();
+        n.set = true;
+        n.old_exprs = next_contract::old_exprs_ref();
+    }
+
+    ~next_contract_scope() { next_contract::ref() = prior_; }
+
+private:
+    next_contract const prior_;
+};
+
+// RAII (until end of full-expression) around old value expressions, so
+// contracts declared by functions they call are nested (see next_contract).
+class old_expr : private boost::noncopyable {
+public:
+    explicit old_expr(bool copy) : copy_(copy) {
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            ++next_contract::old_exprs_ref();
+        #endif
+    }
+
+    ~old_expr() {
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            --next_contract::old_exprs_ref();
+        #endif
+    }
+
+    operator bool() const { return copy_; }
+
+private:
+    bool const copy_;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,60 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_OBSERVER_HPP_
+#define BOOST_CONTRACT_DETAIL_OBSERVER_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/observer.hpp>
+#include <boost/contract/detail/metrics.hpp> // For phases and clock.
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// RAII to notify observer (if one installed when phase begins) at phase end,
+// so just one inlined load and one branch per phase if no observer installed.
+class observe_phase : private boost::noncopyable {
+public:
+    // Cond fills event and keeps this phase active (to notify failures).
+    template<class Cond>
+    explicit observe_phase(Cond& c, metrics_phase p) :
+            observer_(boost::contract::get_observer()), active_(0),
+            begin_(0), notified_(false) {
+        if(BOOST_LIKELY(!observer_)) return;
+        c.observe(event_);
+        event_.phase = static_cast<boost::contract::metrics::phase>(p);
+        active_ = &c.observing();
+        *active_ = this;
+        begin_ = metrics::nanoseconds();
+    }
+
+    ~observe_phase() {
+        if(BOOST_LIKELY(!observer_)) return;
+        *active_ = 0;
+        if(!notified_) notify(false);
+    }
+
+    // Notify once (on failure, before calling failure handler).
+    void notify(bool failed) {
+        notified_ = true;
+        event_.failed = failed;
+        event_.nanoseconds = metrics::nanoseconds() - begin_;
+        observer_->notify(event_);
+    }
+
+private:
+    boost::contract::observer* const observer_;
+    observe_phase** active_;
+    boost::contract::observer_event event_;
+    boost::uint64_t begin_;
+    bool notified_;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -33,13 +33,24 @@ public:
     explicit constructor(C* obj) : cond_inv</* VR = */ none, C>(
             boost::contract::from_constructor, obj) {}
 
+    explicit constructor(constructor& other, cond_move) :
+            cond_inv</* VR = */ none, C>(other, cond_move()) {}
+
 private:
     #if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
-            !defined(BOOST_CONTRACT_NO_OLDS)
+            !defined(BOOST_CONTRACT_NO_OLDS) || ( \
+                !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS) \
+            )
         void init() /* override */ {
+            #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                    defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+                this->enter_object();
+            #endif
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
             #endif
+            if(this->sampled_out()) return;
 
             #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
                 {
@@ -63,6 +74,11 @@ public:
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         ~constructor() BOOST_NOEXCEPT_IF(false) {
             this->assert_initialized();
+            #ifndef BOOST_CONTRACT_NO_INVARIANTS
+                // Body changed obj (unless it threw, then no obj).
+                if(!std::uncaught_exception()) this->bump_epoch();
+            #endif
+            if(this->sampled_out()) return;
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
                 checking k;
@@ -33,13 +33,24 @@ public:
     explicit destructor(C* obj) : cond_inv</* VR = */ none, C>(
             boost::contract::from_destructor, obj) {}
 
+    explicit destructor(destructor& other, cond_move) :
+            cond_inv</* VR = */ none, C>(other, cond_move()) {}
+
 private:
     #if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
-            !defined(BOOST_CONTRACT_NO_OLDS)
+            !defined(BOOST_CONTRACT_NO_OLDS) || ( \
+                !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS) \
+            )
         void init() /* override */ {
+            #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                    defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+                this->enter_object();
+            #endif
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
             #endif
+            if(this->sampled_out()) return;
 
             #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
                 {
@@ -63,6 +74,7 @@ public:
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         ~destructor() BOOST_NOEXCEPT_IF(false) {
             this->assert_initialized();
+            if(this->sampled_out()) return;
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
                 checking k;
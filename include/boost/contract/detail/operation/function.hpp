@@ -30,6 +30,9 @@ public:
     explicit function() : cond_post</* VR = */ none>(
             boost::contract::from_function) {}
 
+    explicit function(function& other, cond_move) :
+            cond_post</* VR = */ none>(other, cond_move()) {}
+
 private:
     #if     !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
             !defined(BOOST_CONTRACT_NO_OLDS)
@@ -37,6 +40,7 @@ private:
             #ifndef  BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
             #endif
+            if(this->sampled_out()) return;
             #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
                 {
                     #if !defined(BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION) && \
@@ -58,6 +62,7 @@ public:
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         ~function() BOOST_NOEXCEPT_IF(false) {
             this->assert_initialized();
+            if(this->sampled_out()) return;
             #ifndef  BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
                 checking k;
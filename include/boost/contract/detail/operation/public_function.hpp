@@ -64,20 +64,38 @@ public:
         )
     {}
 
+    explicit public_function(public_function& other, cond_move) :
+        cond_subcontracting<
+            O, VR, F, C
+            BOOST_CONTRACT_DETAIL_TVARIADIC_COMMA(BOOST_CONTRACT_MAX_ARGS)
+            BOOST_CONTRACT_DETAIL_TVARIADIC_ARGS_Z(1,
+                    BOOST_CONTRACT_MAX_ARGS, Args)
+        >(other, cond_move())
+    {}
+
 private:
     #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) || \
             !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
             !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         void init() /* override */ {
+            #if     !defined(BOOST_CONTRACT_NO_INVARIANTS) && \
+                    defined(BOOST_CONTRACT_NO_NESTED_INVARIANTS)
+                this->enter_subcontracted_object();
+            #endif
             #if     !defined(BOOST_CONTRACT_NO_POSTCONDITIONS) || \
                     !defined(BOOST_CONTRACT_NO_EXCEPTS)
                 this->init_subcontracted_old();
             #endif
             if(!this->base_call()) {
+                #ifndef BOOST_CONTRACT_NO_INVARIANTS
+                    // Body might change obj (also if entry inv not checked).
+                    typename public_function::epoch_bump b(this);
+                #endif
                 #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                     if(checking::already()) return;
                 #endif
+                if(this->sampled_out()) return;
                 { // Acquire checking guard.
                     #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                         checking k;
@@ -133,6 +151,10 @@ public:
         ~public_function() BOOST_NOEXCEPT_IF(false) {
             this->assert_initialized();
             if(!this->base_call()) {
+                #ifndef BOOST_CONTRACT_NO_INVARIANTS
+                    this->bump_epoch(); // Body might have changed obj.
+                #endif
+                if(this->sampled_out()) return;
                 #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                     if(checking::already()) return;
                     checking k;
@@ -34,6 +34,9 @@ public:
     explicit static_public_function() : cond_inv</* VR = */ none, C>(
             boost::contract::from_function, /* obj = */ 0) {}
 
+    explicit static_public_function(static_public_function& other, cond_move) :
+            cond_inv</* VR = */ none, C>(other, cond_move()) {}
+
 private:
     #if     !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
             !defined(BOOST_CONTRACT_NO_PRECONDITIONS) || \
@@ -42,6 +45,7 @@ private:
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
             #endif
+            if(this->sampled_out()) return;
             #if !defined(BOOST_CONTRACT_NO_ENTRY_INVARIANTS) || \
                     !defined(BOOST_CONTRACT_NO_PRECONDITIONS)
                 { // Acquire checking guard.
@@ -76,6 +80,7 @@ public:
             !defined(BOOST_CONTRACT_NO_EXCEPTS)
         ~static_public_function() BOOST_NOEXCEPT_IF(false) {
             this->assert_initialized();
+            if(this->sampled_out()) return;
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 if(checking::already()) return;
                 checking k;
@@ -0,0 +1,87 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_PROBE_HPP_
+#define BOOST_CONTRACT_DETAIL_PROBE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_key.hpp>
+#include <boost/contract/detail/metrics.hpp> // For phase values.
+#include <boost/noncopyable.hpp>
+
+/* PUBLIC */
+
+// Probes emitted as SystemTap SDT notes (same ELF platforms as static keys).
+#if     defined(BOOST_CONTRACT_PROBES) && \
+        defined(BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM)
+    #define BOOST_CONTRACT_DETAIL_PROBES
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_PROBES
+    // Same note (version 3) as <sys/sdt.h> STAP_PROBE2, but without requiring
+    // that header. Arguments are a site pointer and an int, and there is no
+    // semaphore (so a probe is a single NOP, also while traced by uprobes).
+    #define BOOST_CONTRACT_DETAIL_PROBE(name, site, arg) \
+        __asm__ __volatile__( \
+            "990: nop\n\t" \
+            ".pushsection .note.stapsdt, \"\", \"note\"\n\t" \
+            ".balign 4\n\t" \
+            ".4byte 992f-991f, 994f-993f, 3\n\t" \
+            "991: .asciz \"stapsdt\"\n\t" \
+            "992: .balign 4\n\t" \
+            "993: .8byte 990b\n\t" \
+            ".8byte _.stapsdt.base\n\t" \
+            ".8byte 0\n\t" \
+            ".asciz \"boost_contract\"\n\t" \
+            ".asciz \"" #name "\"\n\t" \
+            ".asciz \"8@%0 -4@%1\"\n\t" \
+            "994: .balign 4\n\t" \
+            ".popsection\n\t" \
+            /* base address (to adjust probe addresses, as sdt.h) */ \
+            ".ifndef _.stapsdt.base\n\t" \
+            ".pushsection .stapsdt.base, \"aG\", \"progbits\", " \
+                    ".stapsdt.base, comdat\n\t" \
+            ".weak _.stapsdt.base\n\t" \
+            ".hidden _.stapsdt.base\n\t" \
+            "_.stapsdt.base: .space 1\n\t" \
+            ".size _.stapsdt.base, 1\n\t" \
+            ".popsection\n\t" \
+            ".endif\n\t" \
+            : \
+            : "nor" (static_cast<void const*>(site)), \
+              "nor" (static_cast<int>(arg)) \
+        )
+#else
+    #define BOOST_CONTRACT_DETAIL_PROBE(name, site, arg) /* nothing */
+#endif
+
+/* CODE */
+
+namespace boost { namespace contract { namespace detail {
+
+#ifdef BOOST_CONTRACT_DETAIL_PROBES
+    // RAII to fire probes at begin and end of a contract phase.
+    class probe_phase : private boost::noncopyable {
+    public:
+        explicit probe_phase(site const* s, metrics_phase p) : site_(s),
+                phase_(p) {
+            BOOST_CONTRACT_DETAIL_PROBE(phase_begin, site_, phase_);
+        }
+
+        ~probe_phase() {
+            BOOST_CONTRACT_DETAIL_PROBE(phase_end, site_, phase_);
+        }
+
+    private:
+        site const* const site_;
+        metrics_phase const phase_;
+    };
+#endif
+
+} } } // namespace
+
+#endif // #include guard
+
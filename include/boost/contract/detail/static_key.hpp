@@ -0,0 +1,77 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_STATIC_KEY_HPP_
+#define BOOST_CONTRACT_DETAIL_STATIC_KEY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Included by site.hpp so trivial headers only.
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+
+/* PUBLIC */
+
+// Platforms on which code can be patched at run-time (asm goto to record jump
+// sites, plus 64-bit Linux mprotect to make code writable). Do NOT use config
+// macros BOOST_CONTRACT_... here (also used by lib .cpp).
+#if     defined(__linux__) && defined(__GNUC__) && \
+        (defined(__x86_64__) || defined(__aarch64__))
+    #define BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM
+#endif
+
+// Static keys actually used by user code.
+#if     defined(BOOST_CONTRACT_STATIC_KEYS) && \
+        defined(BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM) && \
+        !defined(BOOST_NO_CXX11_LAMBDAS)
+    #define BOOST_CONTRACT_DETAIL_STATIC_KEYS
+#endif
+
+#ifdef BOOST_CONTRACT_DETAIL_STATIC_KEY_PLATFORM
+    #if defined(__x86_64__)
+        // 5-byte JMP aligned so it can be patched to a 5-byte NOP (and back) by
+        // a single atomic 8-byte store (while other threads might execute it).
+        #define BOOST_CONTRACT_DETAIL_STATIC_KEY_JMP_(label) \
+            ".balign 8\n\t" \
+            "1:\n\t" \
+            ".byte 0xe9\n\t" \
+            ".long %l[" #label "] - (1b + 5)\n\t"
+    #else // __aarch64__
+        // B and NOP can be patched into each other while executed (ARM ARM).
+        #define BOOST_CONTRACT_DETAIL_STATIC_KEY_JMP_(label) \
+            "1:\n\t" \
+            "b %l[" #label "]\n\t"
+    #endif
+
+    // Patched at start-up (and when key toggled) to NOP falling through while
+    // key disabled, or to jump to enabled_label while key enabled. Compiled as
+    // jump to unpatched_label, so code not patched yet (or that cannot be
+    // patched, e.g., W^X policies) must check key state there instead.
+    // Key must be an object with static storage duration.
+    #define BOOST_CONTRACT_DETAIL_STATIC_KEY_JUMP(key, enabled_label, \
+            unpatched_label) \
+        __asm__ goto( \
+            BOOST_CONTRACT_DETAIL_STATIC_KEY_JMP_(unpatched_label) \
+            /* section name is C identifier for __start_ and __stop_ */ \
+            ".pushsection boost_contract_jump_table, \"aw\"\n\t" \
+            ".balign 8\n\t" \
+            ".quad 1b, %l[" #enabled_label "], %c0\n\t" \
+            ".popsection\n\t" \
+            : : "i" (&(key)) : : enabled_label, unpatched_label \
+        )
+#endif
+
+namespace boost { namespace contract { namespace detail {
+
+// Layout of entries emitted by BOOST_CONTRACT_DETAIL_STATIC_KEY_JUMP.
+struct static_key_jump {
+    boost::uint64_t code;
+    boost::uint64_t target; // Enabled label.
+    boost::uint64_t key;
+};
+
+} } } // namespace
+
+#endif // #include guard
+
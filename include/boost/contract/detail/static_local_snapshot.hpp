@@ -0,0 +1,109 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_STATIC_LOCAL_SNAPSHOT_HPP_
+#define BOOST_CONTRACT_DETAIL_STATIC_LOCAL_SNAPSHOT_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Static local var (see static_local_var.hpp) holding an immutable snapshot of
+// T that is atomically published by set() and read by get() without locking
+// (so readers can use the snapshot, e.g., call a failure handler, in parallel
+// and even while another thread sets a new value). Values are expected to be
+// set rarely so replaced snapshots are never deleted while the program runs
+// (lock-free readers could still be using them), they are all deleted at exit.
+// Until set() is first called, get() returns `init` (so no dynamic init).
+template<typename Tag, typename T, typename Init, Init init>
+class static_local_snapshot {
+    struct node {
+        explicit node(T const& v) : value(v), retired(0) {}
+        T const value;
+        node* retired;
+    };
+
+    class nodes : // Non-copyable (owns all nodes).
+        private boost::noncopyable
+    {
+    public:
+        nodes() : retired_(0) {}
+
+        ~nodes() { // At exit, readers get `init` from here on.
+            delete exchange(0); // Delete current node.
+            node* n = retired_.exchange(0, boost::memory_order_acquire);
+            while(n) {
+                node* r = n->retired;
+                delete n;
+                n = r;
+            }
+        }
+
+        void retire(node* n) {
+            node* r = retired_.load(boost::memory_order_relaxed);
+            do { n->retired = r; } while(!retired_.compare_exchange_weak(r, n,
+                    boost::memory_order_release, boost::memory_order_relaxed));
+        }
+
+    private:
+        boost::atomic<node*> retired_;
+    };
+
+    // Node address as integer because atomic pointers are not constant init
+    // on all platforms, while this is (no init guard, so lock-free even on
+    // first get).
+    static boost::atomic<boost::uintptr_t>& current() {
+        static boost::atomic<boost::uintptr_t> data(0);
+        return data;
+    }
+
+    static node const* load() {
+        return reinterpret_cast<node const*>(
+                current().load(boost::memory_order_acquire));
+    }
+
+    static node* exchange(node* n) {
+        return reinterpret_cast<node*>(current().exchange(
+                reinterpret_cast<boost::uintptr_t>(n),
+                boost::memory_order_acq_rel));
+    }
+
+public:
+    static T get() {
+        node const* const n = load();
+        if(n) return n->value;
+        return T(init);
+    }
+
+    // Call snapshot value with the args (without copying it, unlike get).
+    static void call() {
+        node const* const n = load();
+        if(n) n->value();
+        else init();
+    }
+
+    template<typename Arg>
+    static void call(Arg const& arg) {
+        node const* const n = load();
+        if(n) n->value(arg);
+        else init(arg);
+    }
+
+    static T const& set(T const& value) {
+        static nodes all; // Deletes all nodes at exit.
+        node* const n = new node(value);
+        node* const old = exchange(n);
+        if(old) all.retire(old);
+        return value;
+    }
+};
+
+} } } // namespace
+
+#endif // #include guard
+
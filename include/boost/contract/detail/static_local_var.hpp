@@ -7,6 +7,20 @@
 // file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
 // See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
 
+#include <boost/config.hpp>
+
+/* PRIVATE */
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+    #define BOOST_CONTRACT_DETAIL_STATIC_LOCAL_VAR_THREAD_ thread_local
+#elif defined(BOOST_MSVC)
+    #define BOOST_CONTRACT_DETAIL_STATIC_LOCAL_VAR_THREAD_ __declspec(thread)
+#else // GCC, Clang, Intel, etc. (only POD types with constant init).
+    #define BOOST_CONTRACT_DETAIL_STATIC_LOCAL_VAR_THREAD_ __thread
+#endif
+
+/* CODE */
+
 namespace boost { namespace contract { namespace detail {
 
 // This is used to hold the state of this library (already checking assertions,
@@ -35,6 +49,27 @@ struct static_local_var_init {
     }
 };
 
+// Same as above but one var per thread (so no locking needed to access it).
+// NOTE: Pre-C++11 thread-local storage requires T to be POD and init to be a
+// constant expression (true for the counters this is used for).
+template<typename Tag, typename T, typename Init, Init init>
+struct thread_local_var_init {
+    static T& ref() {
+        static BOOST_CONTRACT_DETAIL_STATIC_LOCAL_VAR_THREAD_ T data = init;
+        return data;
+    }
+};
+
+// Same as above but zero-initialized (e.g., for null pointers, which cannot be
+// passed as `init` template params before C++11).
+template<typename Tag, typename T>
+struct thread_local_var {
+    static T& ref() {
+        static BOOST_CONTRACT_DETAIL_STATIC_LOCAL_VAR_THREAD_ T data;
+        return data;
+    }
+};
+
 } } } // namespace
        
 #endif // #include guard
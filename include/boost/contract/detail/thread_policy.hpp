@@ -0,0 +1,43 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_THREAD_POLICY_HPP_
+#define BOOST_CONTRACT_DETAIL_THREAD_POLICY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// IMPORTANT: Included by assertion_level.hpp so trivial headers only.
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+
+namespace boost { namespace contract { namespace detail {
+
+// Per-thread policy set by boost::contract::scoped_policy.
+// NOTE: POD zero-initialized to no override (so accessed like checking, just
+// inlined thread-local reads, no lock and no init guard).
+struct thread_policy {
+    unsigned unchecked; // Bits of checked_conditions NOT checked.
+    bool level_set; // If false, use global assertion level instead.
+    unsigned level;
+
+    static thread_policy& ref() { return data::ref(); }
+
+    static bool checks(unsigned conditions) {
+        return !(ref().unchecked & conditions);
+    }
+
+private:
+    struct data_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<data_tag, thread_policy> data;
+    #else
+        typedef static_local_var<data_tag, thread_policy> data;
+    #endif
+};
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,219 @@
+
+#ifndef BOOST_CONTRACT_DETAIL_TRACE_HPP_
+#define BOOST_CONTRACT_DETAIL_TRACE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_local_var.hpp>
+#include <boost/contract/detail/metrics.hpp> // For clock.
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+
+/* PRIVATE */
+
+// Buffers of ended threads reused (needs thread-local objects with destructor).
+#if     !defined(BOOST_CONTRACT_DISABLE_THREADS) && \
+        !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+    #define BOOST_CONTRACT_DETAIL_TRACE_REUSE_
+#endif
+
+/* CODE */
+
+namespace boost { namespace contract {
+
+class site;
+
+namespace detail {
+
+// Complete event (name, site or base type, begin and end nanoseconds).
+struct trace_event {
+    char const* name;
+    site const* where;
+    char const* type; // Name of base class type (for subcontracted calls).
+    boost::uint64_t begin;
+    boost::uint64_t end;
+};
+
+// Ring of events recorded by one thread and read by one flushing thread (so
+// lock-free, and no RMW on write and read indexes).
+struct trace_buffer : private boost::noncopyable {
+    explicit trace_buffer(std::size_t size) : events(new trace_event[size]),
+            capacity(size), thread(0), next(0), written(0), read(0),
+            dropped(0), released(false) {}
+
+    // Only called by recording thread.
+    void record(trace_event const& e) {
+        std::size_t const w = written.load(boost::memory_order_relaxed);
+        if(w - read.load(boost::memory_order_acquire) >= capacity) {
+            dropped.store(dropped.load(boost::memory_order_relaxed) + 1,
+                    boost::memory_order_relaxed);
+            return; // Full (until flushed).
+        }
+        events[w % capacity] = e;
+        written.store(w + 1, boost::memory_order_release);
+    }
+
+    trace_event* const events; // Never deleted (outlive thread).
+    std::size_t const capacity;
+    // Following set before buffer published (then const).
+    unsigned thread; // Ids only increase along list (so unique).
+    trace_buffer* next;
+    boost::atomic<std::size_t> written;
+    boost::atomic<std::size_t> read;
+    boost::atomic<boost::uint64_t> dropped;
+    // Thread ended, so another thread can reuse this buffer (and its thread
+    // id) once its events are flushed.
+    boost::atomic<bool> released;
+};
+
+} // namespace
+
+/** @cond */
+namespace trace_ {
+    // List of buffers of all threads (shared by all user code linking to this
+    // lib as shared lib, buffers never removed so they outlive their threads).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    boost::atomic<boost::contract::detail::trace_buffer*>& head()
+            BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // Events recorded only while on (i.e., while a recorder exists).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    boost::atomic<bool>& on() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // Size of buffers allocated by threads that did not record yet.
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    boost::atomic<std::size_t>& buffer_size() BOOST_NOEXCEPT_OR_NOTHROW;
+}
+/** @endcond */
+
+namespace detail {
+
+// Per-thread access to trace buffers.
+class trace {
+public:
+    static bool on() {
+        return boost::contract::trace_::on().load(boost::memory_order_relaxed);
+    }
+
+    // Buffer of this thread, reused or allocated on first call (null if out of
+    // memory or after this thread released its buffer at exit).
+    static trace_buffer* buffer() {
+        trace_buffer*& b = local::ref();
+        if(BOOST_LIKELY(b != 0)) return b;
+        #ifdef BOOST_CONTRACT_DETAIL_TRACE_REUSE_
+            if(ended::ref()) return 0; // Checked by thread-local destructors.
+            b = reuse();
+            if(b) return release_at_exit(b);
+        #endif
+        boost::atomic<trace_buffer*>& head = boost::contract::trace_::head();
+        trace_buffer* n = head.load(boost::memory_order_relaxed);
+        std::size_t const size = boost::contract::trace_::buffer_size().load(
+                boost::memory_order_relaxed);
+        try { b = new trace_buffer(size ? size : 1); }
+        catch(...) { return 0; } // Not recorded (but contract checked).
+        do {
+            b->next = n;
+            b->thread = n ? n->thread + 1 : 1;
+        } while(!head.compare_exchange_weak(n, b, boost::memory_order_release,
+                boost::memory_order_relaxed));
+        #ifdef BOOST_CONTRACT_DETAIL_TRACE_REUSE_
+            return release_at_exit(b);
+        #else
+            return b;
+        #endif
+    }
+
+    static void record(char const* name, site const* where, char const* type,
+            boost::uint64_t begin) {
+        if(trace_buffer* b = buffer()) {
+            trace_event e = {name, where, type, begin, metrics::nanoseconds()};
+            b->record(e);
+        }
+    }
+
+private:
+    struct local_tag;
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        typedef thread_local_var<local_tag, trace_buffer*> local;
+    #else
+        typedef static_local_var<local_tag, trace_buffer*> local;
+    #endif
+
+    #ifdef BOOST_CONTRACT_DETAIL_TRACE_REUSE_
+        // Buffer released by an ended thread and already flushed (or never
+        // to be flushed, recorders skip events recorded before them).
+        static trace_buffer* reuse() {
+            for(trace_buffer* b = boost::contract::trace_::head().load(
+                    boost::memory_order_acquire); b; b = b->next) {
+                if(!b->released.load(boost::memory_order_relaxed)) continue;
+                if(on() && b->read.load(boost::memory_order_acquire) !=
+                        b->written.load(boost::memory_order_relaxed)) {
+                    continue; // Not flushed yet.
+                }
+                bool expected = true; // Only one thread claims it.
+                if(b->released.compare_exchange_strong(expected, false,
+                        boost::memory_order_acquire,
+                        boost::memory_order_relaxed)) {
+                    return b;
+                }
+            }
+            return 0;
+        }
+
+        // Thread-local object constructed with buffer (so once per thread).
+        struct releaser {
+            ~releaser() {
+                trace_buffer*& b = local::ref();
+                ended::ref() = true; // So buffer not reallocated after this.
+                if(b) b->released.store(true, boost::memory_order_release);
+                b = 0;
+            }
+        };
+
+        static trace_buffer* release_at_exit(trace_buffer* b) {
+            static thread_local releaser r;
+            (void)r;
+            return b;
+        }
+
+        struct ended_tag;
+        typedef thread_local_var<ended_tag, bool> ended;
+    #endif
+};
+
+// RAII to record a contract phase (if recording on when phase begins).
+class trace_phase : private boost::noncopyable {
+public:
+    explicit trace_phase(char const* name, site const* where,
+            char const* type = 0) : name_(name), where_(where), type_(type),
+            begin_(trace::on() ? metrics::nanoseconds() : 0) {}
+
+    ~trace_phase() {
+        if(begin_) trace::record(name_, where_, type_, begin_);
+    }
+
+private:
+    char const* const name_;
+    site const* const where_;
+    char const* const type_;
+    boost::uint64_t const begin_;
+};
+
+} } } // namespace
+
+/** @cond */
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/trace.hpp>
+#endif
+/** @endcond */
+
+#endif // #include guard
+
@@ -150,6 +150,17 @@
                 (tuple, values))
 #endif
 
+#if BOOST_CONTRACT_DETAIL_TVARIADIC
+    #define BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_COPY_Z(z, \
+            arity, tuple, other_tuple) \
+        tuple(other_tuple)
+#else
+    #define BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_COPY_Z(z, \
+            arity, tuple, other_tuple) \
+        BOOST_PP_ENUM_ ## z(arity, BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_INIT_,\
+                (tuple, other_tuple))
+#endif
+
 #if BOOST_CONTRACT_DETAIL_TVARIADIC
     #define BOOST_CONTRACT_DETAIL_TVARIADIC_TUPLE_INDEXES_TPARAM(indexes) \
         int... indexes
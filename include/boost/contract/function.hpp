@@ -76,8 +76,9 @@ inline specify_precondition_old_postcondition_except<> function() {
     #if     !defined(BOOST_CONTRACT_NO_FUNCTIONS) || \
             !defined(BOOST_CONTRACT_NO_INVARIANTS) || \
              defined(BOOST_CONTRACT_STATIC_LINK)
-        return specify_precondition_old_postcondition_except<>(
-                new boost::contract::detail::function());
+        specify_precondition_old_postcondition_except<> s;
+        s.own_.reset(new(s.own_) boost::contract::detail::function());
+        return s;
     #else
         return specify_precondition_old_postcondition_except<>();
     #endif
@@ -0,0 +1,199 @@
+
+#ifndef BOOST_CONTRACT_METRICS_HPP_
+#define BOOST_CONTRACT_METRICS_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Counters and times of contract and assertion sites.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/detail/metrics.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstddef>
+
+namespace boost { namespace contract { namespace metrics {
+
+/**
+Contract checking phases timed separately for each site.
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+enum phase {
+    /** Checking class invariants at entry. */
+    entry_invariants = boost::contract::detail::metrics_entry_invariants,
+    /** Checking preconditions. */
+    preconditions = boost::contract::detail::metrics_preconditions,
+    /** Copying old values (using the functor passed to @c old(...)). */
+    old_values = boost::contract::detail::metrics_old_values,
+    /** Checking class invariants at exit. */
+    exit_invariants = boost::contract::detail::metrics_exit_invariants,
+    /** Checking postconditions. */
+    postconditions = boost::contract::detail::metrics_postconditions,
+    /** Checking exception guarantees. */
+    excepts = boost::contract::detail::metrics_excepts,
+    /** Number of phases (not a phase). */
+    phases = boost::contract::detail::metrics_phases
+};
+
+/**
+Return the name of a checking phase (e.g., @c "preconditions").
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+inline char const* name(phase p) {
+    switch(p) {
+        case entry_invariants: return "entry_invariants";
+        case preconditions: return "preconditions";
+        case old_values: return "old_values";
+        case exit_invariants: return "exit_invariants";
+        case postconditions: return "postconditions";
+        case excepts: return "excepts";
+        default: return "";
+    }
+}
+
+/**
+Number of latency buckets of each checking phase.
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+int const latency_buckets = boost::contract::detail::metrics_buckets;
+
+/**
+Return the upper bound (in nanoseconds) of a latency bucket.
+
+Bounds are powers of 10 starting from 100 nanoseconds, and the last bucket is
+unbounded (its bound is the largest value of @c boost::uint64_t).
+
+@param bucket   Index of the bucket (from @c 0 to
+                <c>latency_buckets - 1</c>).
+*/
+inline boost::uint64_t latency_bound(int bucket) {
+    return boost::contract::detail::metrics_bound(bucket);
+}
+
+/**
+Counters and times of one contract or assertion site, summed over all threads.
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+struct counters {
+    /** Contract or assertion site of these counters. */
+    boost::contract::site const* where;
+
+    /**
+    Number of times the contract or assertion was reached (also when not
+    checked).
+    */
+    boost::uint64_t calls;
+
+    /**
+    Number of times the contract or assertion was checked (i.e., not sampled
+    out, not disabled, etc.).
+    */
+    boost::uint64_t checks;
+
+    /** Number of times checking the contract or assertion failed. */
+    boost::uint64_t failures;
+
+    /**
+    Nanoseconds spent in each checking phase, indexed by
+    @RefEnum{boost::contract::metrics::phase} (always zero for assertion sites,
+    and before C++11 when no steady clock is available).
+    */
+    boost::uint64_t nanoseconds[phases];
+
+    /**
+    Number of times each checking phase took at most the bound of each latency
+    bucket but more than the bound of the previous bucket, indexed by
+    @RefEnum{boost::contract::metrics::phase} and then by bucket (see
+    @RefFunc{boost::contract::metrics::latency_bound}, always zero when
+    nanoseconds are).
+    */
+    boost::uint64_t latency[phases][latency_buckets];
+
+    /** Number of times a checking phase was timed (sum over all buckets). */
+    boost::uint64_t count(phase p) const {
+        boost::uint64_t n = 0;
+        for(int i = 0; i < latency_buckets; ++i) n += latency[p][i];
+        return n;
+    }
+
+    /** Total nanoseconds spent checking (sum over all phases). */
+    boost::uint64_t total_nanoseconds() const {
+        boost::uint64_t t = 0;
+        for(int i = 0; i < phases; ++i) t += nanoseconds[i];
+        return t;
+    }
+};
+
+/** @cond */
+struct more_expensive {
+    bool operator()(counters const& left, counters const& right) const {
+        boost::uint64_t const l = left.total_nanoseconds();
+        boost::uint64_t const r = right.total_nanoseconds();
+        return l != r ? l > r : left.checks > right.checks;
+    }
+};
+/** @endcond */
+
+/**
+Return the counters of all contract and assertion sites reached so far, from
+the most to the least expensive one.
+
+Counters are only recorded when @RefMacro{BOOST_CONTRACT_METRICS} is defined.
+Each thread writes its own counters (so writers never contend with each other
+nor with readers), and this function merges the counters of all threads
+(including threads that have ended) loading them without any memory ordering
+constraint (so counters of contracts being checked while this function runs
+might be slightly out of sync with each other).
+
+@return Counters of each site (sorted by decreasing total nanoseconds, then by
+        decreasing checks).
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+inline std::vector<counters> snapshot() {
+    std::vector<counters> result;
+    std::map<site const*, std::size_t> index;
+    for(boost::contract::detail::metrics_block const* b =
+            boost::contract::metrics_::head().load(boost::memory_order_acquire);
+            b; b = b->next) {
+        std::map<site const*, std::size_t>::iterator i = index.find(b->where);
+        if(i == index.end()) {
+            counters c = counters();
+            c.where = b->where;
+            i = index.insert(std::make_pair(b->where, result.size())).first;
+            result.push_back(c);
+        }
+        counters& c = result[i->second];
+        c.calls += b->calls.load(boost::memory_order_relaxed);
+        c.checks += b->checks.load(boost::memory_order_relaxed);
+        c.failures += b->failures.load(boost::memory_order_relaxed);
+        for(int p = 0; p < phases; ++p) {
+            c.nanoseconds[p] += b->nanoseconds[p].load(
+                    boost::memory_order_relaxed);
+            for(int i = 0; i < latency_buckets; ++i) {
+                c.latency[p][i] += b->latency[p][i].load(
+                        boost::memory_order_relaxed);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end(), more_expensive());
+    return result;
+}
+
+} } } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,378 @@
+
+#ifndef BOOST_CONTRACT_METRICS_EXPORTER_HPP_
+#define BOOST_CONTRACT_METRICS_EXPORTER_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Write contract metrics as Prometheus exposition text or JSON.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/metrics.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <ostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstddef>
+#ifdef BOOST_HAS_UNISTD_H
+    #include <sys/types.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+/* PRIVATE */
+
+#if     !defined(BOOST_CONTRACT_DISABLE_THREADS) && \
+        !defined(BOOST_NO_CXX11_HDR_THREAD) && \
+        !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+        !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE) && \
+        !defined(BOOST_NO_CXX11_HDR_CHRONO)
+    #define BOOST_CONTRACT_METRICS_EXPORTER_THREAD_
+    #include <thread>
+    #include <mutex>
+    #include <condition_variable>
+    #include <chrono>
+#endif
+
+/* CODE */
+
+namespace boost { namespace contract { namespace metrics {
+
+/**
+Formats to write contract metrics.
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+enum format {
+    /** Prometheus text exposition format. */
+    prometheus,
+    /** JSON (an object with an array of sites). */
+    json
+};
+
+/** @cond */
+namespace exporter_ {
+    inline void seconds(std::ostream& out, boost::uint64_t nanoseconds) {
+        char f = out.fill('0');
+        out << nanoseconds / 1000000000u << '.' << std::setw(9) <<
+                nanoseconds % 1000000000u;
+        out.fill(f);
+    }
+
+    inline void escape_label(std::ostream& out, char const* s) {
+        for(; s && *s; ++s) {
+            if(*s == '\\') out << "\\\\";
+            else if(*s == '"') out << "\\\"";
+            else if(*s == '\n') out << "\\n";
+            else out << *s;
+        }
+    }
+
+    inline void escape_json(std::ostream& out, char const* s) {
+        out << '"';
+        for(; s && *s; ++s) {
+            unsigned char const c = static_cast<unsigned char>(*s);
+            if(c == '\\') out << "\\\\";
+            else if(c == '"') out << "\\\"";
+            else if(c < 0x20) {
+                char u[8];
+                std::sprintf(u, "\\u%04x", static_cast<unsigned>(c));
+                out << u;
+            } else out << *s;
+        }
+        out << '"';
+    }
+
+    inline void labels(std::ostream& out, counters const& c) {
+        out << "file=\"";
+        escape_label(out, c.where->file());
+        out << "\",line=\"" << c.where->line() << "\",function=\"";
+        escape_label(out, c.where->function());
+        out << '"';
+    }
+
+    inline void counter(std::ostream& out, std::vector<counters> const& c,
+            char const* name, char const* help,
+            boost::uint64_t counters::* value) {
+        out << "# HELP " << name << ' ' << help << '\n';
+        out << "# TYPE " << name << " counter\n";
+        for(std::size_t i = 0; i < c.size(); ++i) {
+            out << name << '{';
+            labels(out, c[i]);
+            out << "} " << c[i].*value << '\n';
+        }
+    }
+}
+/** @endcond */
+
+/**
+Write the given contract metrics to an output stream.
+
+Prometheus exposition text reports the counters
+@c boost_contract_calls_total, @c boost_contract_checks_total, and
+@c boost_contract_failures_total (labelled by @c file, @c line, and
+@c function of each site), and the histogram @c boost_contract_check_seconds
+(also labelled by checking @c phase, with one series per timed phase).
+JSON reports an object with the latency bucket bounds in nanoseconds and an
+array with the counters of each site (including per-phase nanoseconds and
+non-cumulative bucket counts).
+
+@param out  Stream to write to.
+@param f    Format to write.
+@param c    Counters to write (usually returned by
+            @RefFunc{boost::contract::metrics::snapshot}).
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+inline void write(std::ostream& out, format f, std::vector<counters> const& c) {
+    if(f == prometheus) {
+        exporter_::counter(out, c, "boost_contract_calls_total",
+                "Contract and assertion site calls.", &counters::calls);
+        exporter_::counter(out, c, "boost_contract_checks_total",
+                "Contract and assertion site checks.", &counters::checks);
+        exporter_::counter(out, c, "boost_contract_failures_total",
+                "Contract and assertion site failures.", &counters::failures);
+        char const* const name = "boost_contract_check_seconds";
+        out << "# HELP " << name << " Time checking contract phases.\n";
+        out << "# TYPE " << name << " histogram\n";
+        for(std::size_t i = 0; i < c.size(); ++i) {
+            for(int p = 0; p < phases; ++p) {
+                boost::uint64_t const n = c[i].count(phase(p));
+                if(n == 0) continue;
+                boost::uint64_t cumulative = 0;
+                for(int b = 0; b < latency_buckets; ++b) {
+                    cumulative += c[i].latency[p][b];
+                    out << name << "_bucket{";
+                    exporter_::labels(out, c[i]);
+                    out << ",phase=\"" << metrics::name(phase(p)) <<
+                            "\",le=\"";
+                    if(b < latency_buckets - 1) {
+                        exporter_::seconds(out, latency_bound(b));
+                    } else out << "+Inf";
+                    out << "\"} " << cumulative << '\n';
+                }
+                out << name << "_sum{";
+                exporter_::labels(out, c[i]);
+                out << ",phase=\"" << metrics::name(phase(p)) << "\"} ";
+                exporter_::seconds(out, c[i].nanoseconds[p]);
+                out << '\n';
+                out << name << "_count{";
+                exporter_::labels(out, c[i]);
+                out << ",phase=\"" << metrics::name(phase(p)) << "\"} " << n <<
+                        '\n';
+            }
+        }
+    } else {
+        out << "{\"latency_bounds_ns\":[";
+        for(int b = 0; b < latency_buckets - 1; ++b) {
+            out << (b ? "," : "") << latency_bound(b);
+        }
+        out << "],\"sites\":[";
+        for(std::size_t i = 0; i < c.size(); ++i) {
+            out << (i ? "," : "") << "\n{\"file\":";
+            exporter_::escape_json(out, c[i].where->file());
+            out << ",\"line\":" << c[i].where->line() << ",\"function\":";
+            exporter_::escape_json(out, c[i].where->function());
+            out << ",\"calls\":" << c[i].calls << ",\"checks\":" <<
+                    c[i].checks << ",\"failures\":" << c[i].failures <<
+                    ",\"phases\":{";
+            bool first = true;
+            for(int p = 0; p < phases; ++p) {
+                if(c[i].count(phase(p)) == 0) continue;
+                out << (first ? "" : ",") << '"' << metrics::name(phase(p)) <<
+                        "\":{\"nanoseconds\":" << c[i].nanoseconds[p] <<
+                        ",\"buckets\":[";
+                for(int b = 0; b < latency_buckets; ++b) {
+                    out << (b ? "," : "") << c[i].latency[p][b];
+                }
+                out << "]}";
+                first = false;
+            }
+            out << "}}";
+        }
+        out << "]}\n";
+    }
+}
+
+/**
+Write the current contract metrics to an output stream.
+
+This is the same as <c>write(out, f, boost::contract::metrics::snapshot())</c>.
+*/
+inline void write(std::ostream& out, format f) { write(out, f, snapshot()); }
+
+/**
+Write contract metrics to a file or file descriptor, on demand or periodically
+from a background thread.
+
+For example, to write Prometheus exposition text every 10 seconds to a file
+read by a node agent:
+
+@code
+int main() {
+    boost::contract::metrics::exporter e("/var/lib/node_exporter/app.prom",
+            boost::contract::metrics::prometheus);
+    e.start(10);
+    ...
+}
+@endcode
+
+Files are written to a temporary file (named as the file plus @c .tmp) that is
+then renamed to the file, so readers never see partially written files.
+File descriptors are written to directly (which requires POSIX), truncating
+them first when they are seekable (e.g., regular files).
+Metrics are formatted before being written, using
+@RefFunc{boost::contract::metrics::snapshot} (which never blocks threads that
+are checking contracts).
+
+@see @RefSect{advanced.contract_metrics, Contract Metrics}
+*/
+class exporter : // Non-copyable (owns thread).
+    private boost::noncopyable
+{
+public:
+    /**
+    Construct this object to write to a file.
+
+    @param path Path of the file (replaced by each write).
+    @param f    Format to write.
+    */
+    explicit exporter(std::string const& path, format f = prometheus) :
+            path_(path), fd_(-1), format_(f)
+        #ifdef BOOST_CONTRACT_METRICS_EXPORTER_THREAD_
+            , stop_(false)
+        #endif
+    {}
+
+    #if defined(BOOST_HAS_UNISTD_H) || defined(BOOST_CONTRACT_DETAIL_DOXYGEN)
+        /**
+        Construct this object to write to a file descriptor (POSIX only).
+
+        @param fd   File descriptor (not closed by this object).
+                    Each write replaces the contents of regular files (by
+                    truncating them first, so readers could see partially
+                    written files), and appends to pipes and sockets.
+        @param f    Format to write.
+        */
+        explicit exporter(int fd, format f = prometheus) : fd_(fd), format_(f)
+            #ifdef BOOST_CONTRACT_METRICS_EXPORTER_THREAD_
+                , stop_(false)
+            #endif
+        {}
+    #endif
+
+    /** Destruct this object (stopping its background thread if started). */
+    ~exporter() {
+        #ifdef BOOST_CONTRACT_METRICS_EXPORTER_THREAD_
+            stop();
+        #endif
+    }
+
+    /**
+    Write the current contract metrics now (from the calling thread).
+
+    @return False if the metrics could not be written.
+    */
+    bool write() {
+        std::ostringstream out;
+        boost::contract::metrics::write(out, format_);
+        std::string const s = out.str();
+        #ifdef BOOST_CONTRACT_METRICS_EXPORTER_THREAD_
+            std::lock_guard<std::mutex> lock(write_mutex_);
+        #endif
+        #ifdef BOOST_HAS_UNISTD_H
+            if(fd_ >= 0) {
+                if(::lseek(fd_, 0, SEEK_CUR) >= 0) { // Seekable so replace.
+                    if(::ftruncate(fd_, 0) != 0) return false;
+                    if(::lseek(fd_, 0, SEEK_SET) < 0) return false;
+                }
+                for(std::size_t n = 0; n < s.size(); ) {
+                    ::ssize_t w = ::write(fd_, s.data() + n, s.size() - n);
+                    if(w < 0 && errno == EINTR) continue;
+                    if(w <= 0) return false;
+                    n += static_cast<std::size_t>(w);
+                }
+                return true;
+            }
+        #endif
+        std::string const tmp = path_ + ".tmp";
+        std::FILE* file = std::fopen(tmp.c_str(), "wb");
+        if(!file) return false;
+        bool ok = std::fwrite(s.data(), 1, s.size(), file) == s.size();
+        ok = std::fclose(file) == 0 && ok;
+        if(ok) ok = std::rename(tmp.c_str(), path_.c_str()) == 0;
+        if(!ok) std::remove(tmp.c_str());
+        return ok;
+    }
+
+    #if     defined(BOOST_CONTRACT_METRICS_EXPORTER_THREAD_) || \
+            defined(BOOST_CONTRACT_DETAIL_DOXYGEN)
+        /**
+        Start a background thread that writes the current contract metrics
+        periodically (C++11 threads only, and not when
+        @RefMacro{BOOST_CONTRACT_DISABLE_THREADS} is defined).
+
+        This does nothing if the background thread is already started.
+
+        @param seconds  Period between two consecutive writes (the first write
+                        is done one period after this call).
+        */
+        void start(double seconds) {
+            if(thread_.joinable()) return;
+            stop_ = false;
+            std::chrono::nanoseconds const period(
+                    static_cast<boost::int64_t>(seconds * 1e9));
+            thread_ = std::thread([this, period] {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while(!stop_cond_.wait_for(lock, period,
+                        [this] { return stop_; })) {
+                    lock.unlock();
+                    write(); // Errors ignored (retried next period).
+                    lock.lock();
+                }
+            });
+        }
+
+        /**
+        Stop the background thread (this does nothing if it is not started).
+        */
+        void stop() {
+            if(!thread_.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            stop_cond_.notify_all();
+            thread_.join();
+        }
+    #endif
+
+/** @cond */
+private:
+    std::string const path_;
+    int const fd_;
+    format const format_;
+    #ifdef BOOST_CONTRACT_METRICS_EXPORTER_THREAD_
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable stop_cond_;
+        bool stop_;
+        std::mutex write_mutex_;
+    #endif
+/** @endcond */
+};
+
+} } } // namespace
+
+#endif // #include guard
+
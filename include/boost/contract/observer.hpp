@@ -0,0 +1,173 @@
+
+#ifndef BOOST_CONTRACT_OBSERVER_HPP_
+#define BOOST_CONTRACT_OBSERVER_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Observe contract checking phases (to build profilers, coverage tools, etc.).
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/contract/metrics.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+
+namespace boost { namespace contract {
+
+class site;
+
+/**
+Event passed to observers at the end of each contract checking phase.
+
+@see @RefClass{boost::contract::observer}
+*/
+struct observer_event {
+    /**
+    Site of the contract (null unless the contract is declared right after a
+    @RefClass{boost::contract::sample} constructed with a site).
+    */
+    site const* where;
+
+    /** Checking phase that ended. */
+    boost::contract::metrics::phase phase;
+
+    /** Kind of operation (constructor, destructor, or function). */
+    boost::contract::from from;
+
+    /**
+    Object of the checked member function (null for non-member functions and
+    for static public functions).
+    */
+    void const volatile* object;
+
+    /**
+    True if this contract is checked for a base class of an overriding public
+    function (see @RefSect{tutorial.public_function_overrides__subcontracting_,
+    Subcontracting}).
+    */
+    bool subcontracted;
+
+    /** True if the assertions of this phase failed. */
+    bool failed;
+
+    /**
+    Time spent checking this phase (0 before C++11).
+    This includes time spent calling this observer for nested contracts.
+    */
+    boost::uint64_t nanoseconds;
+};
+
+/**
+Interface of contract observers.
+
+Observers are called by the thread checking a contract at the end of each of
+its checking phases, only if @RefMacro{BOOST_CONTRACT_OBSERVER} is defined and
+an observer is installed using @RefFunc{boost::contract::set_observer}:
+
+@code
+struct counter : boost::contract::observer {
+    boost::atomic<unsigned long> failures;
+
+    counter() : failures(0) {}
+
+    void notify(boost::contract::observer_event const& e) {
+        if(e.failed) ++failures;
+    }
+};
+
+int main() {
+    static counter c;
+    boost::contract::set_observer(&c);
+    ...
+}
+@endcode
+
+Observers are called before the failure handlers of the phases they observe
+(see @RefSect{advanced.throw_on_failures__and__noexcept__, Throw on Failure}),
+they are called concurrently by all threads checking contracts, and they should
+not throw.
+
+@see @RefSect{advanced.contract_observers, Contract Observers}
+*/
+class observer {
+public:
+    /**
+    Called at the end of each contract checking phase.
+
+    @param event    Site, phase, object, result, and time of the phase.
+    */
+    virtual void notify(observer_event const& event) = 0;
+
+    /** Destruct this observer (it must not be installed anymore). */
+    virtual ~observer() {}
+};
+
+/** @cond */
+namespace observer_ {
+    // Address of installed observer (shared by all user code linking to this
+    // lib as shared lib, 0 if none). Integer because atomic pointers are not
+    // constant init on all platforms (but this is loaded at each phase).
+    #ifndef BOOST_CONTRACT_HEADER_ONLY
+        // Exported variable (not function) so get_observer loads it inline.
+        BOOST_CONTRACT_DETAIL_DECLSPEC
+        extern boost::atomic<boost::uintptr_t> data;
+
+        inline boost::atomic<boost::uintptr_t>& get()
+                BOOST_NOEXCEPT_OR_NOTHROW {
+            return data;
+        }
+    #else
+        inline boost::atomic<boost::uintptr_t>& get()
+                BOOST_NOEXCEPT_OR_NOTHROW; // Local static defined inline.
+    #endif
+}
+/** @endcond */
+
+/**
+Install the observer of all contracts checked by all threads.
+
+The observer must outlive its installation (it is not copied), and observers
+already being called by other threads might still be called after this
+function returns.
+
+@param o    Observer to install (null to install no observer).
+
+@return The observer installed before this call (null if none).
+*/
+inline observer* set_observer(observer* o) BOOST_NOEXCEPT_OR_NOTHROW {
+    return reinterpret_cast<observer*>(observer_::get().exchange(
+        reinterpret_cast<boost::uintptr_t>(o),
+        boost::memory_order_acq_rel
+    ));
+}
+
+/**
+Return the observer of all contracts checked by all threads (null if none).
+
+This is inlined and it only loads an atomic variable of this library (with
+acquire memory ordering so the observer installed by another thread is seen
+fully constructed, which is a plain load on x86), without calling into this
+library also when it is linked as a shared library.
+*/
+inline observer* get_observer() BOOST_NOEXCEPT_OR_NOTHROW {
+    return reinterpret_cast<observer*>(
+            observer_::get().load(boost::memory_order_acquire));
+}
+
+} } // namespace
+
+/** @cond */
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/observer.hpp>
+#endif
+/** @endcond */
+
+#endif // #include guard
+
@@ -16,6 +16,10 @@ Handle old values.
 #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
     #include <boost/contract/detail/checking.hpp>
 #endif
+#ifndef BOOST_CONTRACT_NO_OLDS
+    #include <boost/contract/scoped_policy.hpp>
+#endif
+#include <boost/contract/detail/next_contract.hpp>
 #include <boost/contract/detail/operator_safe_bool.hpp>
 #include <boost/contract/detail/declspec.hpp>
 #include <boost/contract/detail/debug.hpp>
@@ -26,7 +30,6 @@ Handle old values.
 #include <boost/static_assert.hpp>
 #include <boost/preprocessor/control/expr_iif.hpp>
 #include <boost/preprocessor/config/config.hpp>
-#include <queue>
 
 #if !BOOST_PP_VARIADICS
 
@@ -53,16 +56,20 @@ BOOST_CONTRACT_ERROR_macro_OLDOF_requires_variadic_macros_otherwise_manually_pro
         boost::contract::old_ptr<BOOST_TYPEOF(value)>
 #endif
 
+// Temporary old_expr lasts until end of full-expression so contracts of
+// functions called by old value expression do not use this function's sample.
 #define BOOST_CONTRACT_ERROR_macro_OLDOF_has_invalid_number_of_arguments_2( \
         v, value) \
     BOOST_CONTRACT_OLDOF_AUTO_TYPEOF_(value)(boost::contract::make_old(v, \
-        boost::contract::copy_old(v) ? (value) : boost::contract::null_old() \
+        boost::contract::detail::old_expr(boost::contract::copy_old(v)) ? \
+                (value) : boost::contract::null_old() \
     ))
 
 #define BOOST_CONTRACT_ERROR_macro_OLDOF_has_invalid_number_of_arguments_1( \
         value) \
     BOOST_CONTRACT_OLDOF_AUTO_TYPEOF_(value)(boost::contract::make_old( \
-        boost::contract::copy_old() ? (value) : boost::contract::null_old() \
+        boost::contract::detail::old_expr(boost::contract::copy_old()) ? \
+                (value) : boost::contract::null_old() \
     ))
 
 /** @endcond */
@@ -502,7 +509,8 @@ public:
                 >::type* = 0
     )
         #ifndef BOOST_CONTRACT_NO_OLDS
-            : untyped_copy_(new old_value_copy<T>(old))
+            // Copy and its shared count in one allocation.
+            : untyped_copy_(boost::make_shared<old_value_copy<T> >(old))
         #endif // Else, leave ptr_ null (thus no copy of T).
     {}
     
@@ -602,6 +610,10 @@ private:
             } else if(!v_ && boost::contract::detail::checking::already()) {
                 return Ptr(); // Not checking (so return null).
         #endif
+            } else if(!v_ && !untyped_copy_) {
+                return Ptr(); // Sampled out (so not copied and return null).
+            } else if(!v_ && !boost::contract::detail::policy_copies_old()) {
+                return Ptr(); // Not checking post nor except (so return null).
             } else if(!v_) {
                 BOOST_CONTRACT_DETAIL_DEBUG(untyped_copy_);
                 typedef old_value_copy<typename Ptr::element_type> copied_type;
@@ -614,7 +626,8 @@ private:
                 v_->action_ == boost::contract::virtual_::push_old_ftor_copy
             ) {
                 BOOST_CONTRACT_DETAIL_DEBUG(untyped_copy_);
-                std::queue<boost::shared_ptr<void> >& copies = v_->action_ ==
+                boost::contract::virtual_::old_copies_type& copies =
+                        v_->action_ ==
                         boost::contract::virtual_::push_old_ftor_copy ?
                     v_->old_ftor_copies_
                 :
@@ -629,7 +642,8 @@ private:
                 // Copy not null, but still pop it from the queue.
                 BOOST_CONTRACT_DETAIL_DEBUG(!untyped_copy_);
 
-                std::queue<boost::shared_ptr<void> >& copies = v_->action_ ==
+                boost::contract::virtual_::old_copies_type& copies =
+                        v_->action_ ==
                         boost::contract::virtual_::pop_old_ftor_copy ?
                     v_->old_ftor_copies_
                 :
@@ -753,6 +767,10 @@ This function is often only used by the code expanded by
 */
 inline bool copy_old() {
     #ifndef BOOST_CONTRACT_NO_OLDS
+        if(boost::contract::detail::next_contract::sampled_out_owned()) {
+            return false;
+        }
+        if(!boost::contract::detail::policy_copies_old()) return false;
         #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
             return !boost::contract::detail::checking::already();
         #else
@@ -787,6 +805,10 @@ This function is often only used by the code expanded by
 inline bool copy_old(virtual_* v) {
     #ifndef BOOST_CONTRACT_NO_OLDS
         if(!v) {
+            if(boost::contract::detail::next_contract::sampled_out_owned()) {
+                return false;
+            }
+            if(!boost::contract::detail::policy_copies_old()) return false;
             #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
                 return !boost::contract::detail::checking::already();
             #else
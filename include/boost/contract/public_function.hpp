@@ -15,6 +15,7 @@ Overloads handle public functions that are static, virtual void, virtual non-voi
 #include <boost/contract/core/config.hpp>
 #include <boost/contract/core/specify.hpp>
 #include <boost/contract/core/access.hpp>
+#include <boost/contract/core/invariant_epoch.hpp>
 #include <boost/contract/core/virtual.hpp>
 /** @cond */
 // Needed within macro expansions below instead of defined(...) (PRIVATE macro).
@@ -131,8 +132,10 @@ have no static invariants.
 template<class Class>
 specify_precondition_old_postcondition_except<> public_function() {
     #if BOOST_CONTRACT_PUBLIC_FUNCTIONS_IMPL_
-        return specify_precondition_old_postcondition_except<>(
-            new boost::contract::detail::static_public_function<Class>());
+        specify_precondition_old_postcondition_except<> s;
+        s.own_.reset(new(s.own_)
+                boost::contract::detail::static_public_function<Class>());
+        return s;
     #else
         return specify_precondition_old_postcondition_except<>();
     #endif
@@ -212,8 +215,8 @@ no invariants.
 template<class Class>
 specify_precondition_old_postcondition_except<> public_function(Class* obj) {
     #if BOOST_CONTRACT_PUBLIC_FUNCTIONS_IMPL_
-        return specify_precondition_old_postcondition_except<>(
-            new boost::contract::detail::public_function<
+        specify_precondition_old_postcondition_except<> s;
+        s.own_.reset(new(s.own_) boost::contract::detail::public_function<
                 boost::contract::detail::none,
                 boost::contract::detail::none,
                 boost::contract::detail::none,
@@ -236,6 +239,7 @@ specify_precondition_old_postcondition_except<> public_function(Class* obj) {
                 )
             )
         );
+        return s;
     #else
         return specify_precondition_old_postcondition_except<>();
     #endif
@@ -261,9 +265,9 @@ specify_precondition_old_postcondition_except<> public_function(Class* obj) {
     ) { \
         BOOST_PP_IIF(BOOST_CONTRACT_PUBLIC_FUNCTIONS_IMPL_, \
             /* no F... so cannot enforce contracted F returns VirtualResult */ \
-            return (specify_precondition_old_postcondition_except< \
-                    BOOST_PP_EXPR_IIF(has_virtual_result, VirtualResult)>( \
-                new boost::contract::detail::public_function< \
+            specify_precondition_old_postcondition_except< \
+                    BOOST_PP_EXPR_IIF(has_virtual_result, VirtualResult)> s; \
+            s.own_.reset(new(s.own_) boost::contract::detail::public_function< \
                     boost::contract::detail::none, \
                     BOOST_PP_IIF(has_virtual_result, \
                         VirtualResult \
@@ -293,7 +297,8 @@ specify_precondition_old_postcondition_except<> public_function(Class* obj) {
                         boost::contract::detail::none::value() \
                     ) \
                 ) \
-            )); \
+            ); \
+            return s; \
         , \
             return specify_precondition_old_postcondition_except< \
                     BOOST_PP_EXPR_IIF(has_virtual_result, VirtualResult)>(); \
@@ -539,9 +544,9 @@ specify_precondition_old_postcondition_except<> public_function(Class* obj) {
                     "enclosing class missing 'base-types' typedef" \
                 ); \
             } \
-            return (specify_precondition_old_postcondition_except< \
-                    BOOST_PP_EXPR_IIF(has_virtual_result, VirtualResult)>( \
-                new boost::contract::detail::public_function< \
+            specify_precondition_old_postcondition_except< \
+                    BOOST_PP_EXPR_IIF(has_virtual_result, VirtualResult)> s; \
+            s.own_.reset(new(s.own_) boost::contract::detail::public_function< \
                     Override, \
                     BOOST_PP_IIF(has_virtual_result, \
                         VirtualResult \
@@ -569,7 +574,8 @@ specify_precondition_old_postcondition_except<> public_function(Class* obj) {
                     BOOST_CONTRACT_DETAIL_NO_TVARIADIC_ENUM_Z(z, arity_compl, \
                             boost::contract::detail::none::value()) \
                 ) \
-            )); \
+            ); \
+            return s; \
         , \
             return specify_precondition_old_postcondition_except< \
                     BOOST_PP_EXPR_IIF(has_virtual_result, VirtualResult)>(); \
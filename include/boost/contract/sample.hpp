@@ -0,0 +1,294 @@
+
+#ifndef BOOST_CONTRACT_SAMPLE_HPP_
+#define BOOST_CONTRACT_SAMPLE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Check contracts only for a sample of the calls.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/virtual.hpp>
+#ifndef BOOST_CONTRACT_NO_CONDITIONS
+    #include <boost/contract/detail/next_contract.hpp>
+    #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+        #include <boost/contract/detail/checking.hpp>
+    #endif
+    #include <boost/contract/detail/contract_site.hpp>
+#endif
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/config.hpp>
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    #include <chrono>
+#endif
+
+namespace boost { namespace contract {
+
+/**
+Sampling policy that checks contracts for one in every @c N calls.
+
+This is usually declared as a local static variable right before the contract
+declaration (so each contract has its own counter), or as a data member (so
+each object has its own counter), and passed to
+@RefClass{boost::contract::sample}:
+
+@code
+void f(...) {
+    static boost::contract::sampling f_sampling(100); // 1 in 100 calls.
+    boost::contract::sample sampled(f_sampling);
+    boost::contract::old_ptr<old_type> old_var = BOOST_CONTRACT_OLDOF(old_expr);
+    boost::contract::check c = boost::contract::function()
+        ...
+    ;
+
+    ... // Function body.
+}
+@endcode
+
+The call counter is an atomic variable incremented without any memory ordering
+constraint, so the same object can be safely used by multiple threads.
+
+@see @RefSect{advanced.sampling_contract_checks, Sampling Contract Checks}
+*/
+class sampling : // Non-copyable (atomic counter).
+    private boost::noncopyable
+{
+public:
+    /**
+    Construct this object.
+
+    @param period   Check contracts once every @p period calls (starting with
+                    the first call).
+                    Contracts are checked for all calls if this is @c 1 and
+                    never checked if this is @c 0.
+    */
+    explicit sampling(unsigned long period) : period_(period), calls_(0) {}
+
+    /**
+    Return the period currently set (see @RefClass{boost::contract::sampling}
+    constructor).
+    */
+    unsigned long period() const {
+        return period_.load(boost::memory_order_relaxed);
+    }
+
+    /**
+    Set a new period (see @RefClass{boost::contract::sampling} constructor).
+
+    This can be called at any time, also while other threads are using this
+    object.
+    */
+    void period(unsigned long value) {
+        period_.store(value, boost::memory_order_relaxed);
+    }
+
+    /**
+    Count one more call and return true if its contract must be checked.
+    */
+    bool operator()() const {
+        unsigned long const p = period();
+        if(p == 0) return false;
+        return calls_.fetch_add(1, boost::memory_order_relaxed) % p == 0;
+    }
+
+/** @cond */
+private:
+    boost::atomic<unsigned long> period_;
+    mutable boost::atomic<unsigned long> calls_;
+/** @endcond */
+};
+
+#if     !defined(BOOST_NO_CXX11_HDR_CHRONO) || \
+        defined(BOOST_CONTRACT_DETAIL_DOXYGEN)
+    /**
+    Sampling policy that checks contracts at most once in a given time interval.
+
+    This is used as @RefClass{boost::contract::sampling} but it is based on
+    time instead of number of calls, so the overhead of checking contracts
+    remains bounded also for calls that are more frequent than expected
+    (C++11).
+    When multiple threads call a function after the interval expired, only one
+    of them checks the contract.
+
+    @see @RefSect{advanced.sampling_contract_checks, Sampling Contract Checks}
+    */
+    class timed_sampling : // Non-copyable (atomic time).
+        private boost::noncopyable
+    {
+    public:
+        /**
+        Construct this object.
+
+        @param interval Check contracts at most once in this time interval
+                        (starting with the first call).
+        */
+        explicit timed_sampling(std::chrono::steady_clock::duration interval) :
+                interval_(interval.count()), next_(0) {}
+
+        /**
+        Return true if the interval since the last checked contract expired (and
+        start a new interval).
+        */
+        bool operator()() const {
+            std::chrono::steady_clock::rep const now = std::chrono::
+                    steady_clock::now().time_since_epoch().count();
+            std::chrono::steady_clock::rep next =
+                    next_.load(boost::memory_order_relaxed);
+            if(now < next) return false;
+            // Only one thread wins the check for this interval.
+            return next_.compare_exchange_strong(next, now + interval_,
+                    boost::memory_order_relaxed);
+        }
+
+    /** @cond */
+    private:
+        std::chrono::steady_clock::rep const interval_;
+        mutable boost::atomic<std::chrono::steady_clock::rep> next_;
+    /** @endcond */
+    };
+#endif
+
+/**
+Check the contract declared next in the enclosing function only if the
+sampling policy says so.
+
+This must be declared right before the old value and contract declarations
+(because when the contract is sampled out, old values are not copied either):
+
+@code
+void f(...) {
+    static boost::contract::sampling f_sampling(100); // 1 in 100 calls.
+    boost::contract::sample sampled(f_sampling);
+    boost::contract::old_ptr<old_type> old_var = BOOST_CONTRACT_OLDOF(old_expr);
+    boost::contract::check c = boost::contract::function()
+        ...
+    ;
+
+    ... // Function body.
+}
+@endcode
+
+A sampled out contract is not checked at all (no class invariants,
+preconditions, old value copies, postconditions, or exception guarantees), while
+contracts of functions called by the body or by old value expressions copied
+using @RefMacro{BOOST_CONTRACT_OLDOF} are checked as usual (they are sampled by
+their own policies, if any).
+Other contracted functions should not be called between this object and the
+contract declaration (their contracts would be sampled as this one).
+Calls made while checking other contracts are not counted (they are never
+checked, see @RefMacro{BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION}).
+Constructor preconditions are always checked (they are checked before the
+constructor body, see @RefClass{boost::contract::constructor_precondition}).
+Nothing is done when all contracts are disabled at compile-time (see
+@RefMacro{BOOST_CONTRACT_NO_CONDITIONS}), not even calling the policy.
+
+@see @RefSect{advanced.sampling_contract_checks, Sampling Contract Checks}
+*/
+class sample : // Non-copyable (RAII on thread's next contract).
+    private boost::noncopyable
+{
+public:
+    /**
+    Construct this object for non-virtual functions.
+
+    @param policy   Nullary functor returning @c true if the next contract must
+                    be checked (e.g., @RefClass{boost::contract::sampling},
+                    @RefClass{boost::contract::timed_sampling},
+                    @RefClass{boost::contract::budget_sampling}, or any
+                    user-defined functor).
+    */
+    template<class Policy>
+    explicit sample(Policy const& policy) { init(policy, 0); }
+
+    /**
+    Construct this object for virtual public functions and public function
+    overrides.
+
+    @param policy   Same as for the constructor above.
+    @param v    The trailing parameter of type
+                @RefClass{boost::contract::virtual_}<c>*</c> and default value
+                @c 0 from the enclosing virtual public function or public
+                function override (when this library calls the function to
+                check subcontracted contracts, the policy is not called and
+                contracts are always checked).
+    */
+    template<class Policy>
+    explicit sample(Policy const& policy, virtual_* v) { init(policy, v); }
+
+    /**
+    Construct this object for non-virtual functions, when the sampling decision
+    is already known (e.g., @RefMacro{BOOST_CONTRACT_SITE_ENABLED}).
+
+    @param check    True if the next contract must be checked.
+    */
+    explicit sample(bool check) { init(constant(check), 0); }
+
+    /**
+    Construct this object for virtual public functions and public function
+    overrides, when the sampling decision is already known.
+
+    @param check    Same as for the constructor above.
+    @param v    Same as for the constructors above.
+    */
+    explicit sample(bool check, virtual_* v) { init(constant(check), v); }
+
+    /**
+    Destruct this object (forgetting the sampling decision in case no contract
+    was declared after this object, and restoring the one of the calling
+    function in case this function was called by its old value expressions).
+    */
+    ~sample() {}
+
+/** @cond */
+private:
+    struct constant {
+        explicit constant(bool value) : value_(value) {}
+        bool operator()() const { return value_; }
+    private:
+        bool value_;
+    };
+
+    template<class Policy>
+    static void init(Policy const& policy, virtual_* v) {
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            if(v) return; // Called to subcontract, always check.
+            #ifdef BOOST_CONTRACT_DETAIL_CONTRACT_SITES
+                next_site(policy); // Also when not checked (for calls).
+            #endif
+            #ifndef BOOST_CONTRACT_ALL_DISABLE_NO_ASSERTION
+                if(boost::contract::detail::checking::already()) return;
+            #endif
+            // Policy might also set cost of next contract (see budget).
+            bool const checked = policy();
+            boost::contract::detail::next_contract::ref().sampled_out =
+                    !checked;
+        #endif
+    }
+
+    #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+            defined(BOOST_CONTRACT_DETAIL_CONTRACT_SITES)
+        // Only sites identify contracts (for metrics, probes, etc.).
+        static void next_site(site const& s) {
+            boost::contract::detail::next_contract::ref().where = &s;
+        }
+
+        template<class Policy>
+        static void next_site(Policy const&) {}
+    #endif
+
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        // State for next contract of this function (then restored to caller's).
+        boost::contract::detail::next_contract_scope next_;
+    #endif
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,176 @@
+
+#ifndef BOOST_CONTRACT_SCOPED_POLICY_HPP_
+#define BOOST_CONTRACT_SCOPED_POLICY_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Change what the current thread checks until the end of a scope.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/assertion_level.hpp>
+#include <boost/contract/detail/thread_policy.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Contract conditions checked by a @RefClass{boost::contract::scoped_policy}.
+
+These are bits that can be combined using <c>operator|</c> (e.g.,
+<c>checked_preconditions | checked_invariants</c>).
+
+@see @RefSect{advanced.scoped_policies, Scoped Policies}
+*/
+enum checked_conditions {
+    /** Check no condition (old values are not copied either). */
+    checked_none = 0,
+    /** Check class invariants at entry. */
+    checked_entry_invariants = 1,
+    /** Check class invariants at exit. */
+    checked_exit_invariants = 2,
+    /** Check class invariants at entry and exit. */
+    checked_invariants = 3,
+    /** Check preconditions. */
+    checked_preconditions = 4,
+    /**
+    Check postconditions (old values are copied when postconditions or
+    exception guarantees are checked).
+    */
+    checked_postconditions = 8,
+    /**
+    Check exception guarantees (old values are copied when postconditions or
+    exception guarantees are checked).
+    */
+    checked_excepts = 16,
+    /** Check all conditions (this is the default). */
+    checked_all = 31
+};
+
+/** Combine contract conditions checked by a scoped policy. */
+inline checked_conditions operator|(checked_conditions left,
+        checked_conditions right) {
+    return static_cast<checked_conditions>(
+            static_cast<unsigned>(left) | static_cast<unsigned>(right));
+}
+
+/** @cond */
+namespace detail {
+    // Old values copied only if post or except checked by this thread.
+    inline bool policy_copies_old() {
+        return thread_policy::checks(checked_postconditions) ||
+                thread_policy::checks(checked_excepts);
+    }
+}
+/** @endcond */
+
+/**
+RAII object to change the contract conditions and the assertion level checked
+by the current thread until the end of its scope.
+
+For example, a server can check audit assertions only while serving a sample
+of its requests, and check only preconditions while serving all other
+requests:
+
+@code
+void serve(request const& r) {
+    boost::contract::scoped_policy policy(
+        r.audited() ? boost::contract::checked_all :
+                boost::contract::checked_preconditions,
+        r.audited() ? boost::contract::assertion_level_audit :
+                boost::contract::assertion_level_default
+    );
+    ...
+}
+@endcode
+
+The conditions are read once by each contract when its checking starts (so a
+contract checks the same conditions at entry and exit even if its body changes
+the policy), while the assertion level is read by each assertion programmed
+with a level (see @RefMacro{BOOST_CONTRACT_ASSERT_LEVEL} and
+@RefMacro{BOOST_CONTRACT_CHECK_LEVEL}).
+Scoped policies can be nested (the policy in effect before an object of this
+class was constructed is restored when the object is destroyed), and they only
+change the contracts checked by the thread that constructed them (so they never
+race with other threads and they are read from thread-local storage without
+any lock).
+
+Contract conditions and assertion levels disabled at compile-time (e.g., using
+@RefMacro{BOOST_CONTRACT_NO_PRECONDITIONS}) cannot be enabled by this object.
+
+@see @RefSect{advanced.scoped_policies, Scoped Policies}
+*/
+class scoped_policy : // Non-copyable (restores previous policy on destruction).
+    private boost::noncopyable
+{
+public:
+    /**
+    Check the specified contract conditions (without changing the assertion
+    level currently checked by this thread).
+
+    @param conditions   Contract conditions to check (e.g.,
+                        @RefEnum{boost::contract::checked_conditions}
+                        <c>checked_none</c> to check no contract at all).
+    */
+    explicit scoped_policy(checked_conditions conditions) :
+            previous_(boost::contract::detail::thread_policy::ref()) {
+        boost::contract::detail::thread_policy::ref().unchecked =
+                checked_all & ~static_cast<unsigned>(conditions);
+    }
+
+    /**
+    Check the specified assertion level (without changing the contract
+    conditions currently checked by this thread).
+
+    For example, <c>scoped_policy p(assertion_level_audit)</c> also checks
+    audit assertions in the contracts checked by this thread.
+
+    @param level    Assertion level to check instead of the global one set by
+                    @RefFunc{boost::contract::set_assertion_level}.
+    */
+    explicit scoped_policy(unsigned level) :
+            previous_(boost::contract::detail::thread_policy::ref()) {
+        boost::contract::detail::thread_policy& p =
+                boost::contract::detail::thread_policy::ref();
+        p.level_set = true;
+        p.level = level;
+    }
+
+    /**
+    Check the specified contract conditions and assertion level.
+
+    @param conditions   Contract conditions to check.
+    @param level    Assertion level to check instead of the global one set by
+                    @RefFunc{boost::contract::set_assertion_level} (e.g.,
+                    @RefEnum{boost::contract::assertion_level}
+                    <c>assertion_level_audit</c> to also check audit
+                    assertions).
+    */
+    scoped_policy(checked_conditions conditions, unsigned level) :
+            previous_(boost::contract::detail::thread_policy::ref()) {
+        boost::contract::detail::thread_policy& p =
+                boost::contract::detail::thread_policy::ref();
+        p.unchecked = checked_all & ~static_cast<unsigned>(conditions);
+        p.level_set = true;
+        p.level = level;
+    }
+
+    /** Restore the policy in effect before this object was constructed. */
+    ~scoped_policy() {
+        boost::contract::detail::thread_policy::ref() = previous_;
+    }
+
+/** @cond */
+private:
+    boost::contract::detail::thread_policy const previous_;
+/** @endcond */
+};
+
+} } // namespace
+
+#endif // #include guard
+
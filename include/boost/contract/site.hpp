@@ -0,0 +1,423 @@
+
+#ifndef BOOST_CONTRACT_SITE_HPP_
+#define BOOST_CONTRACT_SITE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Enable and disable contracts and assertions at run-time by source location.
+*/
+
+// IMPORTANT: Included by assert.hpp (when BOOST_CONTRACT_SITES) so trivial
+// headers only.
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/detail/static_key.hpp>
+#include <boost/contract/detail/declspec.hpp>
+#include <boost/atomic.hpp>
+#include <boost/current_function.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+
+namespace boost { namespace contract {
+
+class site;
+
+/** @cond */
+namespace site_ {
+    // List head (shared by all user code linking to this lib as shared lib).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    boost::atomic<site*>& head() BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // Register jump sites of a module (see BOOST_CONTRACT_STATIC_KEYS).
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void add_jumps(boost::contract::detail::static_key_jump const* begin,
+            boost::contract::detail::static_key_jump const* end)
+            BOOST_NOEXCEPT_OR_NOTHROW;
+
+    // Patch jump sites of a site to its current state.
+    BOOST_CONTRACT_DETAIL_DECLSPEC
+    void patch(site const* s) BOOST_NOEXCEPT_OR_NOTHROW;
+}
+/** @endcond */
+
+/**
+Descriptor of a contract or assertion site that can be enabled and disabled at
+run-time.
+
+Sites are usually declared using @RefMacro{BOOST_CONTRACT_SITE} as local static
+variables (these are constant-initialized, without any initialization guard)
+and passed to @RefClass{boost::contract::sample} to check the contract that
+follows only while the site is enabled:
+
+@code
+void f(...) {
+    BOOST_CONTRACT_SITE(f_site);
+    boost::contract::sample sampled(f_site);
+    boost::contract::old_ptr<old_type> old_var = BOOST_CONTRACT_OLDOF(old_expr);
+    boost::contract::check c = boost::contract::function()
+        ...
+    ;
+
+    ... // Function body.
+}
+@endcode
+
+Assertions also declare sites when @RefMacro{BOOST_CONTRACT_SITES} is defined.
+A site is added to the list returned by @RefFunc{boost::contract::site::first}
+the first time it is reached (or enabled or disabled), and it is enabled by
+default.
+Checking if a site is enabled costs a single atomic load (without any memory
+ordering constraint) and a single branch, so the same site can be safely used
+by multiple threads (or no load and no branch at all for disabled sites,
+using @RefMacro{BOOST_CONTRACT_SITE_ENABLED} when
+@RefMacro{BOOST_CONTRACT_STATIC_KEYS} is defined).
+
+@see @RefSect{advanced.contract_sites, Contract Sites}
+*/
+class site {
+public:
+    /**
+    Construct this object (this is usually done via
+    @RefMacro{BOOST_CONTRACT_SITE}).
+
+    @param file File name of this site (usually @c __FILE__).
+    @param line Line number of this site (usually @c __LINE__).
+    @param function Name of the function of this site (usually
+                    @c BOOST_CURRENT_FUNCTION).
+    */
+    BOOST_CONSTEXPR site(char const* file, unsigned long line,
+            char const* function) BOOST_NOEXCEPT_OR_NOTHROW :
+        file_(file),
+        line_(line),
+        function_(function),
+        naming_(function ? named : unnamed),
+        state_(unlisted),
+        listed_(false),
+        next_(0)
+    {}
+
+    /** Return the file name of this site. */
+    char const* file() const BOOST_NOEXCEPT_OR_NOTHROW { return file_; }
+
+    /** Return the line number of this site. */
+    unsigned long line() const BOOST_NOEXCEPT_OR_NOTHROW { return line_; }
+
+    /**
+    Return the function name of this site (empty for assertion sites until they
+    are first reached).
+    */
+    char const* function() const BOOST_NOEXCEPT_OR_NOTHROW {
+        return naming_.load(boost::memory_order_acquire) == named ?
+                function_ : "";
+    }
+
+    /**
+    Return true if this site is enabled (and add this site to the list of sites
+    the first time this is called).
+    */
+    bool enabled() const BOOST_NOEXCEPT_OR_NOTHROW {
+        unsigned char const s = state_.load(boost::memory_order_relaxed);
+        if(BOOST_LIKELY(s != unlisted)) return s == on;
+        list();
+        unsigned char expected = unlisted; // Unless enabled by other thread.
+        state_.compare_exchange_strong(expected, on,
+                boost::memory_order_relaxed);
+        return state_.load(boost::memory_order_relaxed) == on;
+    }
+
+    /**
+    Same as @RefFunc{boost::contract::site::enabled} (so this object can be
+    used as a policy for @RefClass{boost::contract::sample}).
+    */
+    bool operator()() const BOOST_NOEXCEPT_OR_NOTHROW { return enabled(); }
+
+    /**
+    Enable or disable this site.
+
+    This can be called at any time, also while other threads are checking the
+    contract or assertion of this site (it also patches code of this site
+    compiled with @RefMacro{BOOST_CONTRACT_STATIC_KEYS}, if any).
+
+    @param value    True to enable this site, false to disable it.
+    */
+    void enable(bool value = true) BOOST_NOEXCEPT_OR_NOTHROW {
+        list();
+        state_.store(value ? on : off, boost::memory_order_relaxed);
+        site_::patch(this);
+    }
+
+    /** Disable this site (same as <c>enable(false)</c>). */
+    void disable() BOOST_NOEXCEPT_OR_NOTHROW { enable(false); }
+
+    /**
+    Return the next site in the list of sites (or null if this is the last
+    site).
+    */
+    site* next() const BOOST_NOEXCEPT_OR_NOTHROW { return next_; }
+
+    /**
+    Return the first site in the list of sites reached so far (or null if no
+    site was reached yet).
+
+    The list can be traversed using @RefFunc{boost::contract::site::next}
+    while other threads add sites to it (sites added after this function
+    returns are not visited).
+    */
+    static site* first() BOOST_NOEXCEPT_OR_NOTHROW {
+        return site_::head().load(boost::memory_order_acquire);
+    }
+
+/** @cond */
+    // Assertion sites are declared within lambdas (to declare them within
+    // expressions), so their function is passed by enclosing code and recorded
+    // once reached (in slow path, so still one load and one branch here).
+    bool enabled(char const* function) const BOOST_NOEXCEPT_OR_NOTHROW {
+        unsigned char const s = state_.load(boost::memory_order_relaxed);
+        if(BOOST_LIKELY(s != unlisted)) return s == on;
+        reached(function);
+        return enabled();
+    }
+
+    void reached(char const* function) const BOOST_NOEXCEPT_OR_NOTHROW {
+        if(BOOST_LIKELY(naming_.load(boost::memory_order_relaxed) == named)) {
+            return;
+        }
+        unsigned char expected = unnamed; // Unless named by other thread.
+        if(naming_.compare_exchange_strong(expected, naming,
+                boost::memory_order_relaxed)) {
+            function_ = function;
+            naming_.store(named, boost::memory_order_release);
+        }
+    }
+
+private:
+    // Copy would break list.
+    site(site const&) /* = delete */;
+    site& operator=(site const&) /* = delete */;
+
+    void list() const BOOST_NOEXCEPT_OR_NOTHROW {
+        if(listed_.exchange(true, boost::memory_order_relaxed)) return;
+        // Lock-free push (sites are static so never removed from list).
+        boost::atomic<site*>& head = site_::head();
+        site* n = head.load(boost::memory_order_relaxed);
+        do { next_ = n; } while(!head.compare_exchange_weak(n,
+                const_cast<site*>(this), boost::memory_order_release,
+                boost::memory_order_relaxed));
+    }
+
+    // Enabled and disabled first so only one branch to check these.
+    enum { on, off, unlisted };
+
+    // Function set once (atomic pointers not constant init on all platforms).
+    enum { unnamed, naming, named };
+
+    char const* const file_;
+    unsigned long const line_;
+    mutable char const* function_; // Null until reached (assertion sites).
+    mutable boost::atomic<unsigned char> naming_;
+    mutable boost::atomic<unsigned char> state_;
+    mutable boost::atomic<bool> listed_;
+    mutable site* next_; // Set once before this is published to the list.
+/** @endcond */
+};
+
+/** @cond */
+namespace site_ {
+    inline bool ends_with(char const* str, char const* end) {
+        char const* s = str;
+        while(*s) ++s;
+        char const* e = end;
+        while(*e) ++e;
+        while(s != str && e != end && *(s - 1) == *(e - 1)) { --s; --e; }
+        return e == end;
+    }
+
+    inline std::size_t enable(char const* file, unsigned long line,
+            bool value) {
+        std::size_t n = 0;
+        for(site* s = site::first(); s; s = s->next()) {
+            if((line == 0 || s->line() == line) && ends_with(s->file(), file)) {
+                s->enable(value);
+                ++n;
+            }
+        }
+        return n;
+    }
+}
+/** @endcond */
+
+/**
+Enable all sites reached so far in the specified source location.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param file Enable sites with a file name that ends with this string (so
+            <c>"a.cpp"</c> matches sites declared in <c>"src/a.cpp"</c>).
+@param line Enable sites declared at this line (or on any line if this is
+            @c 0).
+
+@return Number of sites enabled.
+
+@see @RefSect{advanced.contract_sites, Contract Sites}
+*/
+inline std::size_t enable_sites(char const* file, unsigned long line = 0)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    return site_::enable(file, line, true);
+}
+
+/**
+Disable all sites reached so far in the specified source location.
+
+@b Throws: This is declared @c noexcept (or @c throw() before C++11).
+
+@param file Disable sites with a file name that ends with this string (so
+            <c>"a.cpp"</c> matches sites declared in <c>"src/a.cpp"</c>).
+@param line Disable sites declared at this line (or on any line if this is
+            @c 0).
+
+@return Number of sites disabled.
+
+@see @RefSect{advanced.contract_sites, Contract Sites}
+*/
+inline std::size_t disable_sites(char const* file, unsigned long line = 0)
+        /** @cond */ BOOST_NOEXCEPT_OR_NOTHROW /** @endcond */ {
+    return site_::enable(file, line, false);
+}
+
+} } // namespace
+
+/**
+Declare a local static site variable for the enclosing source location.
+
+This macro is defined by code equivalent to:
+
+@code
+    #define BOOST_CONTRACT_SITE(var) \
+        static boost::contract::site var(__FILE__, __LINE__, \
+                BOOST_CURRENT_FUNCTION)
+@endcode
+
+@see @RefSect{advanced.contract_sites, Contract Sites}
+
+@param var  Name of the local static variable of type
+            @RefClass{boost::contract::site} to declare.
+*/
+#define BOOST_CONTRACT_SITE(var) \
+    static boost::contract::site var(__FILE__, __LINE__, \
+            BOOST_CURRENT_FUNCTION) /* no ; here */
+
+#ifdef BOOST_CONTRACT_DETAIL_DOXYGEN
+    /**
+    Return true if the specified site is enabled.
+
+    This is usually passed to @RefClass{boost::contract::sample} (instead of
+    passing the site itself) to check the contract that follows only while its
+    site is enabled, with no overhead for disabled sites when
+    @RefMacro{BOOST_CONTRACT_STATIC_KEYS} is defined:
+
+    @code
+    void f(...) {
+        BOOST_CONTRACT_SITE(f_site);
+        boost::contract::sample sampled(BOOST_CONTRACT_SITE_ENABLED(f_site));
+        ...
+    }
+    @endcode
+
+    If @RefMacro{BOOST_CONTRACT_STATIC_KEYS} is defined (and supported on the
+    target platform), this expands to a single instruction that is patched to a
+    no-op while the site is disabled (so a disabled site costs no load and no
+    branch) and to a jump while the site is enabled.
+    That instruction is compiled as a jump to the same check as
+    <c>var.enabled()</c>, so that check is used when code cannot be patched.
+    Otherwise, this is the same as <c>var.enabled()</c> (see
+    @RefClass{boost::contract::site}).
+
+    @see @RefSect{advanced.contract_sites, Contract Sites}
+
+    @param var  Site declared using @RefMacro{BOOST_CONTRACT_SITE} (or any other
+                @RefClass{boost::contract::site} object with static storage
+                duration).
+    */
+    #define BOOST_CONTRACT_SITE_ENABLED(var)
+#elif defined(BOOST_CONTRACT_DETAIL_STATIC_KEYS)
+    // Lambda for labels in expression (and var static so no capture needed).
+    // NOP falls through if site disabled (no check), jumps if enabled.
+    #define BOOST_CONTRACT_SITE_ENABLED(var) \
+        ([] () -> bool { \
+            BOOST_CONTRACT_DETAIL_STATIC_KEY_JUMP(var, \
+                    boost_contract_detail_site_enabled, \
+                    boost_contract_detail_site_unpatched); \
+            return false; \
+        boost_contract_detail_site_enabled: \
+            return true; \
+        boost_contract_detail_site_unpatched: \
+            return (var).enabled(); \
+        }())
+#else
+    #define BOOST_CONTRACT_SITE_ENABLED(var) \
+        ((var).enabled())
+#endif
+
+/** @cond */
+// Same as BOOST_CONTRACT_SITE_ENABLED, also recording function (assertion
+// sites).
+#ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+    // Function recorded only once reached while enabled (site listed at
+    // start-up, so disabled sites cost just the NOP).
+    #define BOOST_CONTRACT_DETAIL_SITE_ENABLED_IN(var, function) \
+        ([] (char const* f) -> bool { \
+            BOOST_CONTRACT_DETAIL_STATIC_KEY_JUMP(var, \
+                    boost_contract_detail_site_enabled, \
+                    boost_contract_detail_site_unpatched); \
+            return false; \
+        boost_contract_detail_site_enabled: \
+            (var).reached(f); \
+            return true; \
+        boost_contract_detail_site_unpatched: \
+            (var).reached(f); \
+            return (var).enabled(); \
+        }(function))
+#else
+    #define BOOST_CONTRACT_DETAIL_SITE_ENABLED_IN(var, function) \
+        ((var).enabled(function))
+#endif
+/** @endcond */
+
+/** @cond */
+#ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+    // Defined by linker for this module (null if no jump site in module).
+    extern "C" boost::contract::detail::static_key_jump const
+    __start_boost_contract_jump_table[]
+            __attribute__((weak, visibility("hidden")));
+    extern "C" boost::contract::detail::static_key_jump const
+    __stop_boost_contract_jump_table[]
+            __attribute__((weak, visibility("hidden")));
+
+    namespace boost { namespace contract { namespace detail {
+        namespace {
+            // One per translation unit, but each executable and shared lib
+            // registers its jump table (registering same table again no-op).
+            struct static_key_jumps_init {
+                static_key_jumps_init() {
+                    boost::contract::site_::add_jumps(
+                        __start_boost_contract_jump_table,
+                        __stop_boost_contract_jump_table
+                    );
+                }
+            } const static_key_jumps_init_;
+        }
+    } } }
+#endif
+/** @endcond */
+
+/** @cond */
+#ifdef BOOST_CONTRACT_HEADER_ONLY
+    #include <boost/contract/detail/inlined/site.hpp>
+#endif
+/** @endcond */
+
+#endif // #include guard
+
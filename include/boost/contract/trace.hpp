@@ -0,0 +1,295 @@
+
+#ifndef BOOST_CONTRACT_TRACE_HPP_
+#define BOOST_CONTRACT_TRACE_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Record contract checking phases as a Chrome trace-event timeline.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/detail/trace.hpp>
+#include <boost/contract/detail/metrics.hpp>
+#include <boost/core/demangle.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <sstream>
+#include <ostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstddef>
+#ifdef BOOST_HAS_UNISTD_H
+    #include <unistd.h>
+#endif
+
+/* PRIVATE */
+
+#if     !defined(BOOST_CONTRACT_DISABLE_THREADS) && \
+        !defined(BOOST_NO_CXX11_HDR_THREAD) && \
+        !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+        !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE) && \
+        !defined(BOOST_NO_CXX11_HDR_CHRONO)
+    #define BOOST_CONTRACT_TRACE_THREAD_
+    #include <thread>
+    #include <mutex>
+    #include <condition_variable>
+    #include <chrono>
+#endif
+
+/* CODE */
+
+namespace boost { namespace contract { namespace trace {
+
+/**
+Set the number of events each thread can record before its events are flushed,
+and allocate the buffer of the calling thread.
+
+Each thread allocates its buffer when it records its first event, and
+it never allocates memory again to record events (events are dropped while its
+buffer is full, see @RefClass{boost::contract::trace::recorder}).
+With C++11 thread-local storage, a thread reuses the buffer of an ended thread
+(and its thread id) instead, once the events of that buffer are flushed (so
+programs starting many short-lived threads do not keep allocating buffers).
+Calling this function before starting threads (or at the beginning of each
+thread) moves that allocation out of the first checked contract.
+
+@param events   Number of events of buffers allocated by threads that did not
+                record any event yet (65536 by default).
+*/
+inline void reserve(std::size_t events) {
+    boost::contract::trace_::buffer_size().store(events,
+            boost::memory_order_relaxed);
+    boost::contract::detail::trace::buffer();
+}
+
+/**
+Record contract checking phases and write them to a file in Chrome trace-event
+format (JSON), which can be opened by Perfetto and @c chrome://tracing.
+
+Contract checking phases are recorded only when
+@RefMacro{BOOST_CONTRACT_TRACE} is defined, and only while an object of this
+class exists (at most one object of this class should exist at any given time):
+
+@code
+int main() {
+    boost::contract::trace::recorder r("contracts.json");
+    r.start(1); // Flush recorded events every second.
+    ...
+} // Flush remaining events and close file.
+@endcode
+
+Each thread records its events in its own buffer without locks and without
+allocating memory (after its buffer is allocated, see
+@RefFunc{boost::contract::trace::reserve}), and this object flushes the
+buffers of all threads to the file on demand or periodically from a background
+thread.
+Events recorded while the buffer of a thread is full are dropped (and counted).
+
+@see @RefSect{advanced.contract_timelines, Contract Timelines}
+*/
+class recorder : // Non-copyable (owns file and thread).
+    private boost::noncopyable
+{
+public:
+    /**
+    Construct this object, open the file, and start recording.
+
+    @param path Path of the file (overwritten).
+    */
+    explicit recorder(std::string const& path) :
+        file_(std::fopen(path.c_str(), "wb")),
+        first_(true),
+        start_(boost::contract::detail::metrics::nanoseconds())
+        #ifdef BOOST_CONTRACT_TRACE_THREAD_
+            , stop_(false)
+        #endif
+    {
+        if(file_) std::fputs("[", file_); // JSON array format.
+        // Skip events recorded before (by previous recorders).
+        for(boost::contract::detail::trace_buffer* b = buffers(); b;
+                b = b->next) {
+            b->read.store(b->written.load(boost::memory_order_acquire),
+                    boost::memory_order_release);
+        }
+        boost::contract::trace_::on().store(true, boost::memory_order_relaxed);
+    }
+
+    /**
+    Destruct this object (stop recording, then flush events and close file).
+    */
+    ~recorder() {
+        #ifdef BOOST_CONTRACT_TRACE_THREAD_
+            stop();
+        #endif
+        boost::contract::trace_::on().store(false,
+                boost::memory_order_relaxed);
+        flush();
+        if(file_) {
+            std::fputs("\n]\n", file_);
+            std::fclose(file_);
+        }
+    }
+
+    /** Return true if the file was opened. */
+    bool is_open() const { return file_ != 0; }
+
+    /**
+    Write events recorded by all threads so far to the file now (from the
+    calling thread).
+
+    @return False if the events could not be written.
+    */
+    bool flush() {
+        #ifdef BOOST_CONTRACT_TRACE_THREAD_
+            std::lock_guard<std::mutex> lock(flush_mutex_);
+        #endif
+        if(!file_) return false;
+        std::ostringstream out;
+        for(boost::contract::detail::trace_buffer* b = buffers(); b;
+                b = b->next) {
+            std::size_t const w = b->written.load(boost::memory_order_acquire);
+            std::size_t r = b->read.load(boost::memory_order_relaxed);
+            for(; r != w; ++r) write(out, *b, b->events[r % b->capacity]);
+            b->read.store(r, boost::memory_order_release);
+        }
+        std::string const s = out.str();
+        return std::fwrite(s.data(), 1, s.size(), file_) == s.size() &&
+                std::fflush(file_) == 0;
+    }
+
+    /** Return the number of events dropped so far (by all threads). */
+    boost::uint64_t dropped() const {
+        boost::uint64_t n = 0;
+        for(boost::contract::detail::trace_buffer* b = buffers(); b;
+                b = b->next) {
+            n += b->dropped.load(boost::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    #if     defined(BOOST_CONTRACT_TRACE_THREAD_) || \
+            defined(BOOST_CONTRACT_DETAIL_DOXYGEN)
+        /**
+        Start a background thread that flushes events periodically (C++11
+        threads only, and not when @RefMacro{BOOST_CONTRACT_DISABLE_THREADS}
+        is defined).
+
+        This does nothing if the background thread is already started.
+
+        @param seconds  Period between two consecutive flushes.
+        */
+        void start(double seconds) {
+            if(thread_.joinable()) return;
+            stop_ = false;
+            std::chrono::nanoseconds const period(
+                    static_cast<boost::int64_t>(seconds * 1e9));
+            thread_ = std::thread([this, period] {
+                std::unique_lock<std::mutex> lock(mutex_);
+                while(!stop_cond_.wait_for(lock, period,
+                        [this] { return stop_; })) {
+                    lock.unlock();
+                    flush(); // Errors ignored (retried next period).
+                    lock.lock();
+                }
+            });
+        }
+
+        /**
+        Stop the background thread (this does nothing if it is not started).
+        */
+        void stop() {
+            if(!thread_.joinable()) return;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            stop_cond_.notify_all();
+            thread_.join();
+        }
+    #endif
+
+/** @cond */
+private:
+    static boost::contract::detail::trace_buffer* buffers() {
+        return boost::contract::trace_::head().load(
+                boost::memory_order_acquire);
+    }
+
+    static void microseconds(std::ostream& out, boost::uint64_t nanoseconds) {
+        char f = out.fill('0');
+        out << nanoseconds / 1000u << '.' << std::setw(3) <<
+                nanoseconds % 1000u;
+        out.fill(f);
+    }
+
+    static void escape(std::ostream& out, char const* s) {
+        out << '"';
+        for(; s && *s; ++s) {
+            unsigned char const c = static_cast<unsigned char>(*s);
+            if(c == '\\') out << "\\\\";
+            else if(c == '"') out << "\\\"";
+            else if(c < 0x20) out << ' ';
+            else out << *s;
+        }
+        out << '"';
+    }
+
+    // Complete event ("X"), events before this recorder start at time 0.
+    void write(std::ostream& out,
+            boost::contract::detail::trace_buffer const& b,
+            boost::contract::detail::trace_event const& e) {
+        boost::uint64_t const begin = e.begin > start_ ? e.begin - start_ : 0;
+        boost::uint64_t const end = e.end > start_ ? e.end - start_ : 0;
+        out << (first_ ? "\n" : ",\n") << "{\"name\":\"" << e.name <<
+                "\",\"cat\":\"contract\",\"ph\":\"X\",\"ts\":";
+        microseconds(out, begin);
+        out << ",\"dur\":";
+        microseconds(out, end > begin ? end - begin : 0);
+        out << ",\"pid\":" << pid() << ",\"tid\":" << b.thread <<
+                ",\"args\":{";
+        if(e.where) {
+            out << "\"file\":";
+            escape(out, e.where->file());
+            out << ",\"line\":" << e.where->line() << ",\"function\":";
+            escape(out, e.where->function());
+        }
+        if(e.type) {
+            out << (e.where ? ",\"base\":" : "\"base\":");
+            escape(out, boost::core::demangle(e.type).c_str());
+        }
+        out << "}}";
+        first_ = false;
+    }
+
+    static long pid() {
+        #ifdef BOOST_HAS_UNISTD_H
+            return static_cast<long>(::getpid());
+        #else
+            return 1;
+        #endif
+    }
+
+    std::FILE* const file_;
+    bool first_;
+    boost::uint64_t const start_;
+    #ifdef BOOST_CONTRACT_TRACE_THREAD_
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable stop_cond_;
+        bool stop_;
+        std::mutex flush_mutex_;
+    #endif
+/** @endcond */
+};
+
+} } } // namespace
+
+#endif // #include guard
+
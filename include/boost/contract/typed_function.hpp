@@ -0,0 +1,83 @@
+
+#ifndef BOOST_CONTRACT_TYPED_FUNCTION_HPP_
+#define BOOST_CONTRACT_TYPED_FUNCTION_HPP_
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+/** @file
+Program statically typed contracts for (non-public) functions.
+*/
+
+#include <boost/contract/core/config.hpp>
+#include <boost/contract/core/typed_specify.hpp>
+
+namespace boost { namespace contract {
+
+/**
+Program statically typed contracts for non-member, private and protected
+functions.
+
+This is an opt-in alternative to @RefFunc{boost::contract::function} for
+performance critical functions.
+The object returned by this function and by the following
+@c .precondition(...), @c .old(...), etc. calls carries the concrete types of
+the specified functors (no type erasure, no virtual function, no heap
+allocation), so it must be held by a local @c auto variable (instead of by a
+@RefClass{boost::contract::check} object), and the compiler can then inline all
+contract checking code (C++11):
+
+@code
+void f(...) {
+    boost::contract::old_ptr<old_type> old_var;
+    auto c = boost::contract::typed_function()
+        .precondition([&] { // Optional.
+            BOOST_CONTRACT_ASSERT(...);
+            ...
+        })
+        .old([&] { // Optional.
+            old_var = BOOST_CONTRACT_OLDOF(old_expr);
+            ...
+        })
+        .postcondition([&] { // Optional.
+            BOOST_CONTRACT_ASSERT(...);
+            ...
+        })
+        .except([&] { // Optional.
+            BOOST_CONTRACT_ASSERT(...);
+            ...
+        })
+    ;
+
+    ... // Function body.
+}
+@endcode
+
+Preconditions and old value copies are checked as soon as they are specified
+(i.e., at the declaration of @c c), postconditions and exception guarantees are
+checked when @c c goes out of scope at function exit (as usual).
+Failures are handled calling @RefFunc{boost::contract::precondition_failure},
+etc. as with @RefFunc{boost::contract::function}.
+
+@warning    This library cannot detect at run-time if the returned object is not
+            held by a local variable (see
+            @RefMacro{BOOST_CONTRACT_ON_MISSING_CHECK_DECL}), in which case
+            postconditions and exception guarantees would be checked before the
+            function body (compilers warn about that since C++17).
+
+@see    @RefSect{advanced.statically_typed_contracts,
+        Statically Typed Contracts}
+
+@return The result of this function must be assigned to a local @c auto
+        variable declared just before the function body code.
+*/
+inline typed_specify_precondition_old_postcondition_except typed_function() {
+    return typed_specify_precondition_old_postcondition_except();
+}
+
+} } // namespace
+
+#endif // #include guard
+
@@ -0,0 +1,55 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test failure handlers run in parallel and can reenter (no lock held).
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+std::mutex m;
+std::condition_variable cv;
+unsigned g_in_handler = 0;
+unsigned g_parallel = 0;
+unsigned g_nested = 0;
+
+void handler() {
+    static thread_local bool nested = false;
+    if(nested) {
+        std::lock_guard<std::mutex> lock(m);
+        ++g_nested;
+        return;
+    }
+    nested = true;
+    // Reenter handler registry from within a handler.
+    boost::contract::set_check_failure(boost::contract::get_check_failure());
+    boost::contract::check_failure(); // Failure from within a handler.
+    nested = false;
+
+    // Wait for handler to be entered also by other thread.
+    std::unique_lock<std::mutex> lock(m);
+    ++g_in_handler;
+    cv.notify_all();
+    if(cv.wait_for(lock, std::chrono::seconds(10),
+            [] { return g_in_handler == 2; })) ++g_parallel;
+}
+
+int main() {
+    boost::contract::set_check_failure(&handler);
+    std::thread t1([] { boost::contract::check_failure(); });
+    std::thread t2([] { boost::contract::check_failure(); });
+    t1.join();
+    t2.join();
+
+    BOOST_TEST_EQ(g_in_handler, 2u);
+    BOOST_TEST_EQ(g_parallel, 2u); // Both threads were in handler at once.
+    BOOST_TEST_EQ(g_nested, 2u);
+    return boost::report_errors();
+}
+
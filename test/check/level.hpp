@@ -0,0 +1,94 @@
+
+// no #include guard
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/core/assertion_level.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+struct err {}; // Global decl so visible in MSVC10 lambdas.
+
+unsigned const expensive_level = boost::contract::assertion_level_audit + 1;
+
+bool check_audit() {
+    try { BOOST_CONTRACT_CHECK_AUDIT(false); }
+    catch(err const&) { return true; }
+    return false;
+}
+
+bool check_expensive() {
+    try { BOOST_CONTRACT_CHECK_LEVEL(expensive_level, false); }
+    catch(err const&) { return true; }
+    return false;
+}
+
+bool assert_audit() {
+    try { BOOST_CONTRACT_ASSERT_AUDIT(false); }
+    catch(boost::contract::assertion_failure const&) { return true; }
+    return false;
+}
+
+bool assert_expensive() {
+    try { BOOST_CONTRACT_ASSERT_LEVEL(expensive_level, false); }
+    catch(boost::contract::assertion_failure const&) { return true; }
+    return false;
+}
+
+int main() {
+    boost::contract::set_check_failure([] { throw err(); });
+    
+    #ifndef BOOST_CONTRACT_NO_CHECKS
+        bool const checks = true;
+    #else
+        bool const checks = false;
+    #endif
+    #ifndef BOOST_CONTRACT_NO_ALL
+        bool const asserts = true;
+    #else
+        bool const asserts = false;
+    #endif
+    #ifdef BOOST_CONTRACT_AUDITS
+        bool const audits = true;
+    #else
+        bool const audits = false;
+    #endif
+
+    BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+            unsigned(boost::contract::assertion_level_default));
+    BOOST_TEST_EQ(check_audit(), checks && audits);
+    BOOST_TEST_EQ(check_expensive(), false);
+    BOOST_TEST_EQ(assert_audit(), asserts && audits);
+    BOOST_TEST_EQ(assert_expensive(), false);
+
+    BOOST_TEST_EQ(boost::contract::set_assertion_level(
+            boost::contract::assertion_level_audit),
+            unsigned(boost::contract::assertion_level_audit));
+    BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+            unsigned(boost::contract::assertion_level_audit));
+    BOOST_TEST_EQ(check_audit(), checks);
+    BOOST_TEST_EQ(check_expensive(), false);
+    BOOST_TEST_EQ(assert_audit(), asserts);
+    BOOST_TEST_EQ(assert_expensive(), false);
+
+    boost::contract::set_assertion_level(expensive_level);
+    BOOST_TEST_EQ(check_audit(), checks);
+    BOOST_TEST_EQ(check_expensive(), checks);
+    BOOST_TEST_EQ(assert_audit(), asserts);
+    BOOST_TEST_EQ(assert_expensive(), asserts);
+
+    boost::contract::set_assertion_level(
+            boost::contract::assertion_level_default);
+    BOOST_TEST_EQ(check_audit(), checks && audits);
+    BOOST_TEST_EQ(check_expensive(), false);
+    BOOST_TEST_EQ(assert_audit(), asserts && audits);
+    BOOST_TEST_EQ(assert_expensive(), false);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,13 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test assertion levels selected at run-time (audits always checked).
+
+#ifndef BOOST_CONTRACT_AUDITS
+    #error "build must define AUDITS"
+#endif
+#include "level.hpp"
+
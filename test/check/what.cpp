@@ -0,0 +1,50 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test assertion failure what() string (formatted lazily, maybe truncated).
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <string>
+
+int main() {
+    using boost::contract::assertion_failure;
+
+    BOOST_TEST_EQ(std::string(assertion_failure("f.cpp", 12, "x > 0").what()),
+            "assertion \"x > 0\" failed: file \"f.cpp\", line 12");
+    BOOST_TEST_EQ(std::string(assertion_failure("f.cpp", 0, "x").what()),
+            "assertion \"x\" failed: file \"f.cpp\"");
+    BOOST_TEST_EQ(std::string(assertion_failure("f.cpp", 3).what()),
+            "assertion failed: file \"f.cpp\", line 3");
+    BOOST_TEST_EQ(std::string(assertion_failure("", 3, "x").what()),
+            "assertion \"x\" failed");
+    BOOST_TEST_EQ(std::string(assertion_failure().what()), "assertion failed");
+    
+    assertion_failure a("f.cpp", 4294967295ul, "x");
+    assertion_failure b(a); // Copied before formatted.
+    BOOST_TEST_EQ(std::string(a.what()), std::string(b.what()));
+    BOOST_TEST_EQ(std::string(a.what()),
+            "assertion \"x\" failed: file \"f.cpp\", line 4294967295");
+    BOOST_TEST_EQ(std::string(a.what()), std::string(a.what())); // Cached.
+    BOOST_TEST_EQ(std::string(b.file()), "f.cpp");
+    BOOST_TEST_EQ(b.line(), 4294967295ul);
+    BOOST_TEST_EQ(std::string(b.code()), "x");
+    assertion_failure c(a); // Copied after formatted.
+    BOOST_TEST_EQ(std::string(c.what()), std::string(a.what()));
+    c = assertion_failure("g.cpp", 5); // Assigned after formatted.
+    BOOST_TEST_EQ(std::string(c.what()),
+            "assertion failed: file \"g.cpp\", line 5");
+
+    std::string code(1000, 'x');
+    std::string what = assertion_failure("f.cpp", 1, code.c_str()).what();
+    BOOST_TEST(what.size() > 3);
+    BOOST_TEST(what.size() < code.size());
+    BOOST_TEST_EQ(what.substr(0, 12), "assertion \"x");
+    BOOST_TEST_EQ(what.substr(what.size() - 3), "...");
+
+    return boost::report_errors();
+}
+
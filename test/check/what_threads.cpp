@@ -0,0 +1,32 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test assertion failure what() string formatted once by concurrent threads.
+
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <thread>
+#include <vector>
+#include <string>
+
+int main() {
+    std::string const expected =
+            "assertion \"x > 0\" failed: file \"f.cpp\", line 12";
+    for(unsigned i = 0; i < 100; ++i) {
+        boost::contract::assertion_failure const a("f.cpp", 12, "x > 0");
+        std::vector<std::string> whats(4);
+        std::vector<std::thread> threads;
+        for(std::size_t t = 0; t < whats.size(); ++t) {
+            threads.emplace_back([&a, &whats, t] { whats[t] = a.what(); });
+        }
+        for(std::size_t t = 0; t < threads.size(); ++t) threads[t].join();
+        for(std::size_t t = 0; t < whats.size(); ++t) {
+            BOOST_TEST_EQ(whats[t], expected);
+        }
+    }
+    return boost::report_errors();
+}
+
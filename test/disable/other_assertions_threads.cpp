@@ -0,0 +1,79 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test assertion checking disables other assertions only in the same thread.
+
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+std::mutex m;
+std::condition_variable cv;
+bool f_checking = false; // Set by t1 while checking f's pre.
+bool g_done = false; // Set by t2 after calling g.
+// Each counter only written by one thread (so no data race).
+unsigned g_pre1 = 0; // Written by thread t1.
+unsigned g_pre2 = 0; // Written by thread t2.
+
+void g(unsigned& pre) {
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { ++pre; })
+    ;
+}
+
+void f() {
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {
+            g(g_pre1); // Same thread, so g's pre not checked (checking).
+            // Still checking f's pre while other thread calls g.
+            std::unique_lock<std::mutex> lock(m);
+            f_checking = true;
+            cv.notify_all();
+            cv.wait_for(lock, std::chrono::seconds(10), [] { return g_done; });
+        })
+    ;
+}
+
+int main() {
+    std::thread t1(f);
+    std::thread t2([] {
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            std::unique_lock<std::mutex> lock(m); // Wait t1 in f's pre.
+            cv.wait_for(lock, std::chrono::seconds(10),
+                    [] { return f_checking; });
+            lock.unlock();
+        #endif
+        g(g_pre2); // Other thread, so g's pre checked (even if t1 checking).
+        {
+            std::lock_guard<std::mutex> lock(m);
+            g_done = true;
+        }
+        cv.notify_all();
+    });
+    t1.join();
+    t2.join();
+
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST(f_checking); // So t2 called g while t1 was checking.
+        BOOST_TEST(g_done);
+        BOOST_TEST_EQ(g_pre2, 1u);
+        #ifndef BOOST_CONTRACT_PRECONDITIONS_DISABLE_NO_ASSERTION
+            BOOST_TEST_EQ(g_pre1, 0u); // Same thread disabled nested.
+        #else
+            BOOST_TEST_EQ(g_pre1, 1u);
+        #endif
+    #else
+        BOOST_TEST_EQ(g_pre1, 0u);
+        BOOST_TEST_EQ(g_pre2, 0u);
+    #endif
+    return boost::report_errors();
+}
+
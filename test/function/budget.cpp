@@ -0,0 +1,92 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test free function contracts throttled to stay within a checking budget.
+
+#include <boost/contract/budget.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#ifdef BOOST_CONTRACT_DETAIL_CHECK_COST_TICKS
+
+boost::contract::budget b(0.000001, 4); // Way over budget (small window).
+boost::contract::budget_sampling f_sampling(b);
+
+unsigned long pres = 0;
+volatile unsigned long spin = 0;
+
+void f() {
+    boost::contract::sample sampled(f_sampling);
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {
+            ++pres;
+            for(int i = 0; i < 10000; ++i) ++spin; // Expensive pre.
+        })
+    ;
+}
+
+boost::contract::budget g_budget(1, 4); // Never throttled (so just measured).
+boost::contract::budget_sampling g_sampling(g_budget);
+
+int h() { // Contract in g's old value expr (so not measured for g).
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {
+            for(int i = 0; i < 10000; ++i) ++spin; // Expensive pre.
+        })
+    ;
+    return 0;
+}
+
+void g() {
+    boost::contract::sample sampled(g_sampling);
+    boost::contract::old_ptr<int> old_h = BOOST_CONTRACT_OLDOF(h());
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {}) // Cheap pre.
+    ;
+}
+
+int main() {
+    BOOST_TEST_EQ(f_sampling.period(), 1u); // Not checked yet.
+    BOOST_TEST_EQ(b.overhead(), 0.0);
+
+    unsigned long const calls = 1000;
+    for(unsigned long i = 0; i < calls; ++i) f();
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST(b.overhead() > 0);
+        BOOST_TEST(f_sampling.period() > 1u);
+        BOOST_TEST(pres > 0);
+        BOOST_TEST(pres < calls / 2); // Throttled.
+    #else
+        BOOST_TEST_EQ(pres, 0u);
+    #endif
+
+    b.fraction(1); // Never throttle.
+    BOOST_TEST_EQ(b.fraction(), 1.0);
+    BOOST_TEST_EQ(f_sampling.period(), 1u);
+    pres = 0;
+    for(unsigned long i = 0; i < calls; ++i) f();
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(f_sampling.period(), 1u);
+        BOOST_TEST_EQ(pres, calls);
+    #else
+        BOOST_TEST_EQ(pres, 0u);
+    #endif
+
+    for(int i = 0; i < 100; ++i) g();
+    BOOST_TEST(g_budget.overhead() < 0.5); // Not h's expensive pre.
+
+    return boost::report_errors();
+}
+
+#else
+
+int main() { return 0; } // This test trivially passes with no tick counter.
+
+#endif
+
@@ -0,0 +1,55 @@
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test budget overhead is per thread (not summed over threads checking).
+
+#include <boost/contract/budget.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <thread>
+#include <vector>
+
+#ifdef BOOST_CONTRACT_DETAIL_CHECK_COST_TICKS
+
+boost::contract::budget b(1, 16); // Never throttled (so just measured).
+boost::contract::budget_sampling f_sampling(b);
+
+void spin() {
+    volatile unsigned long n = 0;
+    for(int i = 0; i < 10000; ++i) ++n;
+}
+
+void f() { // About half of each thread time checking.
+    boost::contract::sample sampled(f_sampling);
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { spin(); })
+    ;
+    spin();
+}
+
+int main() {
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; ++i) {
+        threads.push_back(std::thread([] {
+            for(int j = 0; j < 1000; ++j) f();
+        }));
+    }
+    for(std::size_t i = 0; i < threads.size(); ++i) threads[i].join();
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST(b.overhead() > 0);
+        BOOST_TEST(b.overhead() < 0.9); // Not about 4 times 0.5 (i.e., 1).
+    #else
+        BOOST_TEST_EQ(b.overhead(), 0.0);
+    #endif
+    return boost::report_errors();
+}
+
+#else
+
+int main() { return 0; } // This test trivially passes with no tick counter.
+
+#endif
@@ -0,0 +1,102 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contracts checked only at outermost levels of nested contracted calls.
+
+#include <boost/contract/core/check_depth.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#ifndef BOOST_CONTRACT_CHECK_DEPTH
+    #error "build must define BOOST_CONTRACT_CHECK_DEPTH"
+#endif
+
+unsigned pres = 0, olds = 0, posts = 0, invs = 0;
+
+int fact(int n) {
+    int result;
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { ++pres; })
+        .old([&] { ++olds; })
+        .postcondition([&] { ++posts; })
+    ;
+    return result = n <= 1 ? 1 : n * fact(n - 1);
+}
+
+struct a {
+    void invariant() const { ++invs; }
+
+    int f(int n) {
+        boost::contract::check c = boost::contract::public_function(this);
+        return fact(n); // Test depth counts public and free functions.
+    }
+};
+
+void reset() { pres = olds = posts = invs = 0; }
+
+int main() {
+    BOOST_TEST_EQ(boost::contract::get_check_depth(), 0u);
+
+    reset();
+    BOOST_TEST_EQ(fact(5), 120); // Test all depths checked by default.
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(pres, 5u);
+    #endif
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        BOOST_TEST_EQ(olds, 5u);
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_EQ(posts, 5u);
+    #endif
+
+    BOOST_TEST_EQ(boost::contract::set_check_depth(2), 2u);
+    BOOST_TEST_EQ(boost::contract::get_check_depth(), 2u);
+    reset();
+    BOOST_TEST_EQ(fact(5), 120);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(pres, 2u);
+    #endif
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        BOOST_TEST_EQ(olds, 2u); // Test old values not copied either.
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_EQ(posts, 2u);
+    #endif
+
+    reset();
+    a aa;
+    BOOST_TEST_EQ(aa.f(5), 120);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(pres, 1u);
+    #endif
+    BOOST_TEST_EQ(invs, 0u
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            + 1
+        #endif
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            + 1
+        #endif
+    );
+
+    reset();
+    BOOST_TEST_EQ(fact(5), 120); // Test depth back to zero after calls.
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(pres, 2u);
+    #endif
+
+    boost::contract::set_check_depth(0); // Test no limit again.
+    reset();
+    BOOST_TEST_EQ(fact(5), 120);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(pres, 5u);
+    #endif
+
+    return boost::report_errors();
+}
+
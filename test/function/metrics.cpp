@@ -0,0 +1,216 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test counters of contract and assertion sites.
+
+#include <boost/contract/metrics.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+#include <cstddef>
+
+#ifndef BOOST_CONTRACT_METRICS
+    #error "build must define BOOST_CONTRACT_METRICS"
+#endif
+
+boost::contract::site const* f_where = 0;
+boost::contract::site const* h_where = 0;
+unsigned long assert_line = 0;
+
+void f(int x) {
+    BOOST_CONTRACT_SITE(f_site);
+    f_where = &f_site;
+    boost::contract::sample sampled(f_site);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            assert_line = __LINE__; BOOST_CONTRACT_ASSERT(x >= 0);
+        })
+    ;
+}
+
+void g() { // Test no counters with no site.
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {})
+    ;
+}
+
+volatile unsigned long spin = 0;
+
+void h() { // Test most expensive first.
+    BOOST_CONTRACT_SITE(h_site);
+    h_where = &h_site;
+    boost::contract::sample sampled(h_site);
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {
+            for(int i = 0; i < 100000; ++i) ++spin;
+        })
+    ;
+}
+
+unsigned long positive_line = 0;
+
+bool positive(int x) {
+    positive_line = __LINE__; BOOST_CONTRACT_ASSERT(true);
+    return x > 0;
+}
+
+unsigned long k_line = 0;
+
+void k(int x) { // Test failure counted for outer of nested assertions.
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            k_line = __LINE__; BOOST_CONTRACT_ASSERT(positive(x));
+        })
+    ;
+}
+
+boost::contract::site const* m_where = 0;
+
+int o() { // Contract declared after m's sample (but in old value expr).
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { BOOST_CONTRACT_ASSERT(true); })
+    ;
+    return 1;
+}
+
+void m(int x) { // Test callee contract in old value expr not counted for m.
+    BOOST_CONTRACT_SITE(m_site);
+    m_where = &m_site;
+    boost::contract::sample sampled(m_site);
+    boost::contract::old_ptr<int> old_o = BOOST_CONTRACT_OLDOF(o());
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { BOOST_CONTRACT_ASSERT(x >= 0); })
+    ;
+}
+
+struct paged_site { // Sites one page apart (same set in per-thread caches).
+    paged_site() : s(__FILE__, __LINE__, "paged") {}
+    boost::contract::site s;
+    char page[4096 - sizeof(boost::contract::site)];
+};
+
+paged_site pages[16];
+
+void p(boost::contract::site const& s) {
+    boost::contract::sample sampled(s);
+    boost::contract::check c = boost::contract::function()
+        .precondition([] {})
+    ;
+}
+
+// Counters of site (or of site at line if null site).
+boost::contract::metrics::counters find(boost::contract::site const* where,
+        unsigned long line = 0) {
+    std::vector<boost::contract::metrics::counters> c =
+            boost::contract::metrics::snapshot();
+    for(std::size_t i = 0; i < c.size(); ++i) {
+        if(where ? c[i].where == where : c[i].where->line() == line) {
+            return c[i];
+        }
+    }
+    return boost::contract::metrics::counters();
+}
+
+int main() {
+    boost::contract::set_precondition_failure([] (boost::contract::from) {});
+    BOOST_TEST(boost::contract::metrics::snapshot().empty());
+
+    g();
+    BOOST_TEST(boost::contract::metrics::snapshot().empty());
+
+    for(int i = 0; i < 3; ++i) f(i);
+    f(-1);
+    boost::contract::metrics::counters c = find(f_where);
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        BOOST_TEST(c.where == f_where);
+        BOOST_TEST_EQ(c.calls, 4u);
+        BOOST_TEST_EQ(c.checks, 4u);
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            BOOST_TEST_EQ(c.failures, 1u);
+        #else
+            BOOST_TEST_EQ(c.failures, 0u);
+        #endif
+    #else
+        BOOST_TEST(!c.where);
+    #endif
+
+    c = find(0, assert_line);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(c.calls, 4u);
+        BOOST_TEST_EQ(c.checks, 4u);
+        BOOST_TEST_EQ(c.failures, 1u);
+    #else
+        BOOST_TEST(!c.where);
+    #endif
+
+    k(-1);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        c = find(0, k_line);
+        BOOST_TEST_EQ(c.checks, 1u);
+        BOOST_TEST_EQ(c.failures, 1u);
+        c = find(0, positive_line);
+        BOOST_TEST_EQ(c.checks, 1u);
+        BOOST_TEST_EQ(c.failures, 0u); // Not nested assertion checked last.
+    #endif
+
+    // Test calls counted but not checks when site disabled.
+    boost::contract::site* s = const_cast<boost::contract::site*>(f_where);
+    s->disable();
+    f(-1);
+    s->enable();
+    c = find(f_where);
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        BOOST_TEST_EQ(c.calls, 5u);
+        BOOST_TEST_EQ(c.checks, 4u);
+    #endif
+
+    m(-1);
+    m(1);
+    c = find(m_where);
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        BOOST_TEST_EQ(c.calls, 2u);
+        BOOST_TEST_EQ(c.checks, 2u);
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            BOOST_TEST_EQ(c.failures, 1u); // Only m's (not o's).
+        #endif
+    #else
+        BOOST_TEST(!c.where);
+    #endif
+
+    for(int i = 0; i < 3; ++i) {
+        for(std::size_t j = 0; j < sizeof pages / sizeof pages[0]; ++j) {
+            p(pages[j].s);
+        }
+    }
+    for(std::size_t j = 0; j < sizeof pages / sizeof pages[0]; ++j) {
+        c = find(&pages[j].s);
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            BOOST_TEST_EQ(c.calls, 3u);
+            BOOST_TEST_EQ(c.checks, 3u);
+        #endif
+    }
+
+    h();
+    std::vector<boost::contract::metrics::counters> all =
+            boost::contract::metrics::snapshot();
+    #if     !defined(BOOST_CONTRACT_NO_PRECONDITIONS) && \
+            !defined(BOOST_NO_CXX11_HDR_CHRONO)
+        BOOST_TEST(!all.empty());
+        if(!all.empty()) {
+            BOOST_TEST(all[0].where == h_where);
+            BOOST_TEST(all[0].nanoseconds[
+                    boost::contract::metrics::preconditions] > 0u);
+        }
+    #endif
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,111 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract metrics written as Prometheus text and JSON.
+
+#include <boost/contract/metrics_exporter.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+#ifndef BOOST_CONTRACT_METRICS
+    #error "build must define BOOST_CONTRACT_METRICS"
+#endif
+
+void f(int x) {
+    BOOST_CONTRACT_SITE(f_site);
+    boost::contract::sample sampled(f_site);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { if(x < 0) throw x; })
+    ;
+}
+
+bool contains(std::string const& s, std::string const& what) {
+    return s.find(what) != std::string::npos;
+}
+
+std::string read(std::string const& path) {
+    std::ifstream file(path.c_str());
+    std::ostringstream s;
+    s << file.rdbuf();
+    return s.str();
+}
+
+int main() {
+    boost::contract::set_precondition_failure([] (boost::contract::from) {});
+    f(1);
+    f(-1);
+
+    std::ostringstream prom;
+    boost::contract::metrics::write(prom, boost::contract::metrics::prometheus);
+    std::ostringstream json;
+    boost::contract::metrics::write(json, boost::contract::metrics::json);
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        BOOST_TEST(contains(prom.str(), "# TYPE boost_contract_calls_total "
+                "counter\nboost_contract_calls_total{file=\""));
+        BOOST_TEST(contains(prom.str(), "metrics_export.cpp\",line=\""));
+        BOOST_TEST(contains(prom.str(), "f(int)\"} 2\n"));
+        BOOST_TEST(contains(json.str(), "\"calls\":2,\"checks\":2,"));
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            BOOST_TEST(contains(prom.str(), "\"} 2\n"
+                    "# HELP boost_contract_failures_total"));
+            BOOST_TEST(contains(prom.str(), ",phase=\"preconditions\","
+                    "le=\"0.000000100\"}"));
+            BOOST_TEST(contains(prom.str(), ",phase=\"preconditions\","
+                    "le=\"+Inf\"} 2\n"));
+            BOOST_TEST(contains(prom.str(), "boost_contract_check_seconds_count"
+                    "{"));
+            BOOST_TEST(contains(json.str(), "\"failures\":1,\"phases\":{"
+                    "\"preconditions\":{\"nanoseconds\":"));
+        #endif
+    #else
+        BOOST_TEST(!contains(prom.str(), "boost_contract_calls_total{"));
+        BOOST_TEST(contains(json.str(), "\"sites\":[]"));
+    #endif
+
+    std::string const path = "metrics_export.prom";
+    std::remove(path.c_str());
+    boost::contract::metrics::exporter e(path);
+    BOOST_TEST(e.write());
+    BOOST_TEST_EQ(read(path), prom.str());
+    std::remove(path.c_str());
+
+    #ifdef BOOST_HAS_UNISTD_H
+        { // Test writes to file descriptors replace previous writes.
+            std::FILE* file = std::fopen(path.c_str(), "wb");
+            BOOST_TEST(file);
+            if(file) {
+                boost::contract::metrics::exporter d(fileno(file));
+                BOOST_TEST(d.write());
+                BOOST_TEST(d.write());
+                std::fclose(file);
+            }
+            BOOST_TEST_EQ(read(path), prom.str());
+            std::remove(path.c_str());
+        }
+    #endif
+
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        e.start(0.001); // Test written periodically.
+        for(int i = 0; i < 1000 && read(path).empty(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        e.stop();
+        BOOST_TEST_EQ(read(path), prom.str());
+        std::remove(path.c_str());
+    #endif
+
+    return boost::report_errors();
+}
+
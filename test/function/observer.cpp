@@ -0,0 +1,149 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test observer notified at end of each contract checking phase.
+
+#include <boost/contract/observer.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+
+#ifndef BOOST_CONTRACT_OBSERVER
+    #error "build must define BOOST_CONTRACT_OBSERVER"
+#endif
+
+struct recorder : boost::contract::observer {
+    std::vector<boost::contract::observer_event> events;
+
+    void notify(boost::contract::observer_event const& e) {
+        events.push_back(e);
+    }
+
+    unsigned count(boost::contract::metrics::phase p, bool failed) const {
+        unsigned n = 0;
+        for(std::size_t i = 0; i < events.size(); ++i) {
+            if(events[i].phase == p && events[i].failed == failed) ++n;
+        }
+        return n;
+    }
+};
+
+struct b {
+    void invariant() const {}
+
+    virtual void f(int x, boost::contract::virtual_* v = 0) {
+        boost::contract::check c = boost::contract::public_function(v, this)
+            .precondition([&] { BOOST_CONTRACT_ASSERT(x > 0); })
+        ;
+    }
+};
+
+struct a
+    #define BASES public b
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    void invariant() const {}
+
+    virtual void f(int x, boost::contract::virtual_* v = 0) /* override */ {
+        boost::contract::check c = boost::contract::public_function<override_f>(
+                v, &a::f, this, x)
+            .precondition([&] { BOOST_CONTRACT_ASSERT(x >= 0); })
+        ;
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+BOOST_CONTRACT_SITE(g_site);
+
+void g(int x) {
+    boost::contract::sample sampled(g_site);
+    boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(x);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { BOOST_CONTRACT_ASSERT(x >= 0); })
+        .postcondition([&] { BOOST_CONTRACT_ASSERT(x == *old_x); })
+    ;
+}
+
+int main() {
+    boost::contract::set_precondition_failure([] (boost::contract::from) {});
+    recorder r;
+    g(1); // Not observed (no observer installed yet).
+    BOOST_TEST(!boost::contract::get_observer());
+    BOOST_TEST(!boost::contract::set_observer(&r));
+    BOOST_TEST_EQ(boost::contract::get_observer(), &r);
+
+    g(1);
+    g(-1);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::preconditions, false),
+                1u);
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::preconditions, true),
+                1u); // Notified once (at failure).
+        BOOST_TEST(r.events.front().where == &g_site);
+        BOOST_TEST(r.events.front().from == boost::contract::from_function);
+        BOOST_TEST(!r.events.front().object);
+        BOOST_TEST(!r.events.front().subcontracted);
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            unsigned const checked = 1; // Not checked after failed pre.
+        #else
+            unsigned const checked = 2;
+        #endif
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::old_values, false),
+                checked);
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::postconditions, false),
+                checked);
+    #endif
+
+    r.events.clear();
+    a aa;
+    aa.f(0); // Base pre fails, but overriding pre passes.
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::preconditions, true),
+                1u);
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::preconditions, false),
+                1u);
+    #endif
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::entry_invariants,
+                false), 2u); // For base and overriding function.
+    #endif
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        BOOST_TEST_EQ(r.count(boost::contract::metrics::exit_invariants,
+                false), 2u);
+    #endif
+    unsigned subcontracted = 0;
+    for(std::size_t i = 0; i < r.events.size(); ++i) {
+        BOOST_TEST(r.events[i].object ==
+                static_cast<void const volatile*>(&aa));
+        BOOST_TEST(!r.events[i].where);
+        if(r.events[i].subcontracted) ++subcontracted;
+    }
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        BOOST_TEST(subcontracted > 0);
+        BOOST_TEST(subcontracted < r.events.size());
+    #endif
+
+    BOOST_TEST_EQ(boost::contract::set_observer(0), &r);
+    r.events.clear();
+    g(-1);
+    aa.f(1);
+    BOOST_TEST(r.events.empty()); // Not observed (no observer installed).
+    return boost::report_errors();
+}
+
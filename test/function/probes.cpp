@@ -0,0 +1,91 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test static probes emitted as SDT notes in this test binary.
+
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#ifndef BOOST_CONTRACT_PROBES
+    #error "build must define BOOST_CONTRACT_PROBES"
+#endif
+
+#if     defined(BOOST_CONTRACT_DETAIL_PROBES) && \
+        !defined(BOOST_CONTRACT_NO_PRECONDITIONS)
+
+#include <elf.h>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <set>
+#include <string>
+#include <cstring>
+
+int pres = 0;
+
+void f(int x) {
+    BOOST_CONTRACT_SITE(f_site);
+    boost::contract::sample sampled(f_site);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            ++pres;
+            if(x < 0) throw x;
+        })
+    ;
+}
+
+// Names of probes of provider in .note.stapsdt section of ELF64 file.
+std::set<std::string> probes(char const* path, std::string const& provider) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<char> const elf((std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+    std::set<std::string> result;
+    if(elf.size() < sizeof(Elf64_Ehdr)) return result;
+    Elf64_Ehdr const* h = reinterpret_cast<Elf64_Ehdr const*>(&elf[0]);
+    Elf64_Shdr const* s = reinterpret_cast<Elf64_Shdr const*>(&elf[h->e_shoff]);
+    char const* names = &elf[s[h->e_shstrndx].sh_offset];
+    for(int i = 0; i < h->e_shnum; ++i) {
+        if(std::strcmp(names + s[i].sh_name, ".note.stapsdt") != 0) continue;
+        for(std::size_t n = s[i].sh_offset; n < s[i].sh_offset + s[i].sh_size;
+                ) {
+            Elf64_Nhdr const* note = reinterpret_cast<Elf64_Nhdr const*>(
+                    &elf[n]);
+            std::size_t const name = n + sizeof(Elf64_Nhdr);
+            std::size_t const desc = name + ((note->n_namesz + 3) & ~3u);
+            if(note->n_type == 3) { // Desc: pc, base, semaphore, strings.
+                char const* p = &elf[desc + 3 * 8];
+                if(provider == p) result.insert(p + std::strlen(p) + 1);
+            }
+            n = desc + ((note->n_descsz + 3) & ~3u);
+        }
+    }
+    return result;
+}
+
+int main() {
+    boost::contract::set_precondition_failure([] (boost::contract::from) {});
+    f(1);
+    f(-1);
+    BOOST_TEST_EQ(pres, 2); // Probes do not change checking.
+
+    std::set<std::string> const p = probes("/proc/self/exe", "boost_contract");
+    BOOST_TEST(p.count("contract"));
+    BOOST_TEST(p.count("phase_begin"));
+    BOOST_TEST(p.count("phase_end"));
+    BOOST_TEST(p.count("failure"));
+    BOOST_TEST(probes("/proc/self/exe", "other").empty());
+    return boost::report_errors();
+}
+
+#else
+
+int main() { return 0; } // This test trivially passes with no probes.
+
+#endif
+
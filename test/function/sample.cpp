@@ -0,0 +1,175 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test free function contracts checked only for sampled calls.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/sample.hpp>
+#include <boost/contract/typed_function.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+boost::contract::test::detail::oteststream out;
+
+struct policy {
+    bool check;
+    bool operator()() const { out << "policy" << std::endl; return check; }
+} p;
+
+void g() {
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { out << "g::pre" << std::endl; })
+        .postcondition([] { out << "g::post" << std::endl; })
+    ;
+    out << "g::body" << std::endl;
+}
+
+void f(int& x) {
+    boost::contract::sample sampled(p);
+    boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(x);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            out << "f::pre" << std::endl;
+            BOOST_CONTRACT_ASSERT(x >= 0);
+        })
+        .postcondition([&] {
+            out << "f::post" << std::endl;
+            BOOST_CONTRACT_ASSERT(old_x); // Old copied if post checked.
+            BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+        })
+    ;
+    out << "f::body" << std::endl;
+    g(); // Test callee contract still checked.
+    ++x;
+}
+
+void t(int& x) {
+    boost::contract::sample sampled(p);
+    boost::contract::old_ptr<int> old_x;
+    auto c = boost::contract::typed_function()
+        .precondition([&] { out << "t::pre" << std::endl; })
+        .old([&] {
+            out << "t::old" << std::endl;
+            old_x = BOOST_CONTRACT_OLDOF(x);
+        })
+        .postcondition([&] {
+            out << "t::post" << std::endl;
+            BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+        })
+    ;
+    out << "t::body" << std::endl;
+    g(); // Test callee contract still checked.
+    ++x;
+}
+
+std::string ok_g() {
+    std::ostringstream ok; ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "g::pre" << std::endl
+        #endif
+        << "g::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "g::post" << std::endl
+        #endif
+    ;
+    return ok.str();
+}
+
+int main() {
+    std::ostringstream ok;
+    int x = 0;
+
+    p.check = true;
+    out.str("");
+    f(x);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "policy" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+        #endif
+        << "f::body" << std::endl
+        << ok_g()
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "f::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 1);
+
+    p.check = false;
+    out.str("");
+    f(x);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "policy" << std::endl
+        #endif
+        << "f::body" << std::endl
+        << ok_g()
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 2);
+
+    p.check = true;
+    out.str("");
+    t(x);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "policy" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "t::pre" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            << "t::old" << std::endl
+        #endif
+        << "t::body" << std::endl
+        << ok_g()
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "t::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 3);
+
+    p.check = false;
+    out.str("");
+    t(x);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "policy" << std::endl
+        #endif
+        << "t::body" << std::endl
+        << ok_g()
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 4);
+
+    // Sampled out without any following contract does not affect next one.
+    {
+        boost::contract::sample sampled(p);
+    }
+    out.str("");
+    g();
+    BOOST_TEST(out.eq(ok_g()));
+
+    // Counting policy checks first call and then once every period calls.
+    boost::contract::sampling s(3);
+    unsigned checked = 0;
+    for(unsigned i = 0; i < 7; ++i) if(s()) ++checked;
+    BOOST_TEST_EQ(checked, 3u); // Calls 1, 4, and 7.
+    s.period(0);
+    BOOST_TEST(!s());
+    BOOST_TEST_EQ(s.period(), 0ul);
+
+    return boost::report_errors();
+}
+
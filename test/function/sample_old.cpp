@@ -0,0 +1,106 @@
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test sample not used by contracts of functions called by old value exprs.
+
+#include <boost/contract/observer.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <vector>
+
+#ifndef BOOST_CONTRACT_OBSERVER
+    #error "build must define BOOST_CONTRACT_OBSERVER"
+#endif
+
+struct recorder : boost::contract::observer {
+    std::vector<boost::contract::observer_event> events;
+
+    void notify(boost::contract::observer_event const& e) {
+        events.push_back(e);
+    }
+
+    unsigned count(boost::contract::site const* where,
+            boost::contract::metrics::phase p) const {
+        unsigned n = 0;
+        for(std::size_t i = 0; i < events.size(); ++i) {
+            if(events[i].where == where && events[i].phase == p) ++n;
+        }
+        return n;
+    }
+};
+
+int h() { // No sample (so must not consume g's).
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { BOOST_CONTRACT_ASSERT(true); })
+    ;
+    return 1;
+}
+
+int k() { // Nested sample (so must not reset g's at its end).
+    boost::contract::sample sampled(true);
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { BOOST_CONTRACT_ASSERT(true); })
+    ;
+    return 2;
+}
+
+BOOST_CONTRACT_SITE(g_site);
+
+void g() {
+    boost::contract::sample sampled(g_site);
+    boost::contract::old_ptr<int> old_h = BOOST_CONTRACT_OLDOF(h());
+    boost::contract::old_ptr<int> old_k = BOOST_CONTRACT_OLDOF(k());
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { BOOST_CONTRACT_ASSERT(true); })
+        .postcondition([&] {
+            BOOST_CONTRACT_ASSERT(old_h && *old_h == 1);
+            BOOST_CONTRACT_ASSERT(old_k && *old_k == 2);
+        })
+    ;
+}
+
+int main() {
+    recorder r;
+    boost::contract::set_observer(&r);
+    g(); // Checked, and so are h and k (called by old value exprs).
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(r.count(&g_site, boost::contract::metrics::preconditions),
+                1u);
+        BOOST_TEST(r.events.back().where == &g_site); // Last g's contract.
+        #ifndef BOOST_CONTRACT_NO_OLDS // Else h and k not called.
+            BOOST_TEST_EQ(r.count(0, boost::contract::metrics::preconditions),
+                    2u);
+            BOOST_TEST(!r.events.front().where); // First h's contract.
+        #endif
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_EQ(r.count(&g_site, boost::contract::metrics::old_values),
+                1u);
+        BOOST_TEST_EQ(r.count(&g_site,
+                boost::contract::metrics::postconditions), 1u);
+    #endif
+
+    r.events.clear();
+    g_site.disable();
+    g(); // Sampled out (so old value exprs not evaluated, h and k not called).
+    #ifndef BOOST_CONTRACT_NO_CONDITIONS
+        BOOST_TEST(r.events.empty());
+    #endif
+
+    g_site.enable();
+    r.events.clear();
+    h(); // After g's sample (not consumed by h nor k) is gone.
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(r.count(0, boost::contract::metrics::preconditions), 1u);
+    #endif
+
+    boost::contract::set_observer(0);
+    return boost::report_errors();
+}
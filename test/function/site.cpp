@@ -0,0 +1,141 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract and assertion sites enabled and disabled at run-time.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+#include <cstring>
+
+boost::contract::test::detail::oteststream out;
+
+unsigned long assert_line = 0;
+char const* assert_function = "";
+
+void f(int x) {
+    BOOST_CONTRACT_SITE(f_site);
+    boost::contract::sample sampled(f_site);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            out << "f::pre" << std::endl;
+            assert_function = BOOST_CURRENT_FUNCTION;
+            assert_line = __LINE__; BOOST_CONTRACT_ASSERT(x >= 0);
+        })
+    ;
+    out << "f::body" << std::endl;
+}
+
+boost::contract::site* find_site(unsigned long line) {
+    for(boost::contract::site* s = boost::contract::site::first(); s;
+            s = s->next()) {
+        if(s->line() == line) return s;
+    }
+    return 0;
+}
+
+unsigned count_sites(char const* function = 0) {
+    unsigned n = 0;
+    for(boost::contract::site* s = boost::contract::site::first(); s;
+            s = s->next()) {
+        if(!function || std::strstr(s->function(), function)) ++n;
+    }
+    return n;
+}
+
+int main() {
+    std::ostringstream ok;
+    boost::contract::set_precondition_failure([] (boost::contract::from) {
+        out << "f::pre_failure" << std::endl;
+    });
+
+    #ifndef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+        BOOST_TEST_EQ(count_sites(), 0u); // Sites listed only once reached.
+    #endif
+
+    out.str("");
+    f(-1);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+            << "f::pre_failure" << std::endl
+        #endif
+        << "f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(count_sites(), 2u); // Contract and assertion sites.
+        boost::contract::site* assert_site = find_site(assert_line);
+        BOOST_TEST(assert_site);
+        if(assert_site) { // Function enclosing assertion (not internal one).
+            BOOST_TEST_EQ(std::string(assert_site->function()),
+                    std::string(assert_function));
+        }
+    #elif !defined(BOOST_CONTRACT_NO_CONDITIONS)
+        BOOST_TEST_EQ(count_sites(), 1u); // Contract site only.
+    #endif
+
+    // Disable assertion site only (by line).
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(boost::contract::disable_sites("function/site.cpp",
+                assert_line), 1u);
+    #endif
+    out.str("");
+    f(-1);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+        #endif
+        << "f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    // Disable entire contract site (by file).
+    BOOST_TEST_EQ(boost::contract::enable_sites("site.cpp"), count_sites());
+    BOOST_TEST_EQ(boost::contract::disable_sites("other.cpp"), 0u);
+    for(boost::contract::site* s = boost::contract::site::first(); s;
+            s = s->next()) {
+        if(s->line() != assert_line) s->disable();
+    }
+    out.str("");
+    f(-1);
+    ok.str(""); ok << "f::body" << std::endl;
+    BOOST_TEST(out.eq(ok.str()));
+
+    // Re-enable all sites.
+    BOOST_TEST_EQ(boost::contract::enable_sites(""), count_sites());
+    out.str("");
+    f(-1);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+            << "f::pre_failure" << std::endl
+        #endif
+        << "f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    // Site declared in local scope also listed (with its function name).
+    {
+        BOOST_CONTRACT_SITE(main_site);
+        BOOST_TEST(main_site.enabled());
+        BOOST_TEST(main_site());
+        main_site.disable();
+        BOOST_TEST(!main_site.enabled());
+        BOOST_TEST(!main_site());
+        BOOST_TEST_EQ(main_site.line(), (unsigned long)(__LINE__ - 6));
+    }
+    BOOST_TEST_EQ(count_sites("main"), 1u);
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,172 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract and assertion sites toggled by patching code at run-time.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/cstdint.hpp>
+#include <sstream>
+#include <cstring>
+
+boost::contract::test::detail::oteststream out;
+
+unsigned long assert_line = 0;
+char const* assert_function = "";
+
+void f(int x) {
+    BOOST_CONTRACT_SITE(f_site);
+    boost::contract::sample sampled(BOOST_CONTRACT_SITE_ENABLED(f_site));
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] {
+            out << "f::pre" << std::endl;
+            assert_function = BOOST_CURRENT_FUNCTION;
+            assert_line = __LINE__; BOOST_CONTRACT_ASSERT(x >= 0);
+        })
+    ;
+    out << "f::body" << std::endl;
+}
+
+unsigned long g_line = 0;
+
+bool g() {
+    g_line = __LINE__; BOOST_CONTRACT_SITE(g_site);
+    return BOOST_CONTRACT_SITE_ENABLED(g_site);
+}
+
+boost::contract::site* find_site(char const* function) {
+    for(boost::contract::site* s = boost::contract::site::first(); s;
+            s = s->next()) {
+        if(std::strcmp(s->function(), function) == 0) return s;
+    }
+    return 0;
+}
+
+#ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+    // Read code back to check all jump sites of s patched to jump or NOP.
+    bool patched(boost::contract::site const* s, bool jump) {
+        unsigned n = 0;
+        for(boost::contract::detail::static_key_jump const* j =
+                __start_boost_contract_jump_table;
+                j != __stop_boost_contract_jump_table; ++j) {
+            if(j->key != reinterpret_cast<boost::uint64_t>(s)) continue;
+            ++n;
+            #if defined(__x86_64__)
+                unsigned char ins[5];
+                std::memcpy(ins, reinterpret_cast<void const*>(j->code),
+                        sizeof ins);
+                if(jump) {
+                    boost::int32_t rel;
+                    std::memcpy(&rel, ins + 1, sizeof rel);
+                    if(ins[0] != 0xe9 || j->code + 5 + rel != j->target) {
+                        return false;
+                    }
+                } else {
+                    unsigned char const nop[5] = {0x0f, 0x1f, 0x44, 0x00, 0x00};
+                    if(std::memcmp(ins, nop, sizeof nop) != 0) return false;
+                }
+            #else // __aarch64__
+                boost::uint32_t ins;
+                std::memcpy(&ins, reinterpret_cast<void const*>(j->code),
+                        sizeof ins);
+                if(jump) {
+                    boost::int64_t const rel = static_cast<boost::int32_t>(
+                            ins << 6) >> 4; // Sign-extended imm26 * 4.
+                    if((ins & 0xfc000000) != 0x14000000 ||
+                            j->code + rel != j->target) {
+                        return false;
+                    }
+                } else if(ins != 0xd503201f) return false;
+            #endif
+        }
+        return n > 0;
+    }
+#endif
+
+int main() {
+    std::ostringstream ok;
+    boost::contract::set_precondition_failure([] (boost::contract::from) {
+        out << "f::pre_failure" << std::endl;
+    });
+
+    #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+        // Sites with jump sites listed at start-up (even if not reached yet).
+        BOOST_TEST(find_site("bool g()"));
+    #endif
+
+    BOOST_TEST(g());
+    boost::contract::site* g_site = find_site("bool g()");
+    BOOST_TEST(g_site);
+    if(g_site) {
+        // Toggle multiple times (and check inlined copies patched too).
+        for(int i = 0; i < 3; ++i) {
+            g_site->disable();
+            BOOST_TEST(!g());
+            BOOST_TEST(!g_site->enabled());
+            #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+                BOOST_TEST(patched(g_site, /* jump = */ false));
+            #endif
+            g_site->enable();
+            BOOST_TEST(g());
+            BOOST_TEST(g_site->enabled());
+            #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+                BOOST_TEST(patched(g_site, /* jump = */ true));
+            #endif
+        }
+        BOOST_TEST_EQ(g_site->line(), g_line);
+    }
+
+    out.str("");
+    f(-1);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+            << "f::pre_failure" << std::endl
+        #endif
+        << "f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        // Function enclosing assertion (not internal one).
+        BOOST_TEST(find_site(assert_function));
+    #endif
+
+    // Disable assertion site only (by line).
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(boost::contract::disable_sites("site_static_keys.cpp",
+                assert_line), 1u);
+    #endif
+    out.str("");
+    f(-1);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+        #endif
+        << "f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    // Disable entire contract site.
+    BOOST_TEST(boost::contract::enable_sites("site_static_keys.cpp") > 0);
+    boost::contract::site* f_site = find_site("void f(int)");
+    BOOST_TEST(f_site);
+    if(f_site) f_site->disable();
+    #ifdef BOOST_CONTRACT_DETAIL_STATIC_KEYS
+        BOOST_TEST(patched(f_site, /* jump = */ false));
+    #endif
+    out.str("");
+    f(-1);
+    ok.str(""); ok << "f::body" << std::endl;
+    BOOST_TEST(out.eq(ok.str()));
+
+    return boost::report_errors();
+}
+
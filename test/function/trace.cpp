@@ -0,0 +1,184 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contract checking phases recorded as Chrome trace events.
+
+#include <boost/contract/trace.hpp>
+#include <boost/contract/site.hpp>
+#include <boost/contract/sample.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+#ifndef BOOST_CONTRACT_TRACE
+    #error "build must define BOOST_CONTRACT_TRACE"
+#endif
+
+struct b {
+    void invariant() const {}
+
+    virtual void f(int x, boost::contract::virtual_* v = 0) {
+        boost::contract::check c = boost::contract::public_function(v, this)
+            .precondition([&] { BOOST_CONTRACT_ASSERT(x >= 0); })
+            .postcondition([] {})
+        ;
+    }
+};
+
+struct a
+    #define BASES public b
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    void invariant() const {}
+
+    virtual void f(int x, boost::contract::virtual_* v = 0) /* override */ {
+        BOOST_CONTRACT_SITE(f_site);
+        boost::contract::sample sampled(f_site);
+        boost::contract::check c = boost::contract::public_function<override_f>(
+                v, &a::f, this, x)
+            .precondition([&] { BOOST_CONTRACT_ASSERT(x >= 0); })
+            .postcondition([] {})
+        ;
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+int g(int& x) {
+    BOOST_CONTRACT_SITE(g_site);
+    boost::contract::sample sampled(g_site);
+    boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(x);
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { BOOST_CONTRACT_ASSERT(x >= 0); })
+        .postcondition([&] { BOOST_CONTRACT_ASSERT(x == *old_x + 1); })
+    ;
+    return ++x;
+}
+
+bool contains(std::string const& s, std::string const& what) {
+    return s.find(what) != std::string::npos;
+}
+
+std::string read(std::string const& path) {
+    std::ifstream file(path.c_str());
+    std::ostringstream s;
+    s << file.rdbuf();
+    return s.str();
+}
+
+int main() {
+    std::string const path = "trace.json";
+    int x = 0;
+    g(x); // Not recorded (no recorder yet).
+
+    boost::contract::trace::reserve(1024);
+    {
+        boost::contract::trace::recorder r(path);
+        BOOST_TEST(r.is_open());
+        a aa;
+        aa.f(1);
+        g(x);
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            std::thread t([&] { g(x); }); // Recorded in its own buffer.
+            t.join();
+        #endif
+        BOOST_TEST(r.flush());
+        BOOST_TEST_EQ(r.dropped(), 0u);
+    }
+    g(x); // Not recorded (no recorder anymore).
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        BOOST_TEST_EQ(x, 4); // Recording does not change checking.
+    #else
+        BOOST_TEST_EQ(x, 3);
+    #endif
+
+    std::string const json = read(path);
+    #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+            !defined(BOOST_NO_CXX11_HDR_CHRONO)
+        BOOST_TEST(contains(json, "[\n{\"name\":\""));
+        BOOST_TEST(contains(json, "}}\n]\n"));
+        BOOST_TEST(contains(json, "\"cat\":\"contract\",\"ph\":\"X\",\"ts\":"));
+        BOOST_TEST(contains(json, "{\"name\":\"body\","));
+        BOOST_TEST(contains(json, "\"args\":{\"file\":\""));
+        BOOST_TEST(contains(json, "trace.cpp\",\"line\":"));
+        BOOST_TEST(contains(json, "g(int&)\"}}"));
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            BOOST_TEST(contains(json, "{\"name\":\"preconditions\","));
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            BOOST_TEST(contains(json, "{\"name\":\"old_values\","));
+        #endif
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            BOOST_TEST(contains(json, "{\"name\":\"postconditions\","));
+        #endif
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            BOOST_TEST(contains(json, "{\"name\":\"entry_invariants\","));
+        #endif
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            BOOST_TEST(contains(json, "{\"name\":\"exit_invariants\","));
+        #endif
+        BOOST_TEST(contains(json, "{\"name\":\"subcontract\","));
+        BOOST_TEST(contains(json, ",\"base\":\"b\"}}"));
+        #ifndef BOOST_CONTRACT_DISABLE_THREADS
+            BOOST_TEST(contains(json, "\"tid\":2,"));
+        #endif
+    #else
+        BOOST_TEST_EQ(json, "[\n]\n");
+    #endif
+    std::remove(path.c_str());
+
+    #ifndef BOOST_CONTRACT_DISABLE_THREADS
+        { // Test flushed periodically.
+            boost::contract::trace::recorder r(path);
+            g(x);
+            r.start(0.001);
+            #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+                    !defined(BOOST_NO_CXX11_HDR_CHRONO)
+                for(int i = 0; i < 1000 && !contains(read(path), "body"); ++i) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                BOOST_TEST(contains(read(path), "{\"name\":\"body\","));
+            #endif
+            r.stop();
+        }
+        BOOST_TEST(contains(read(path), "]\n"));
+        std::remove(path.c_str());
+    #endif
+
+    #ifdef BOOST_CONTRACT_DETAIL_TRACE_REUSE_
+        { // Test buffer of ended thread reused once flushed.
+            boost::contract::trace::recorder r(path);
+            for(int i = 0; i < 3; ++i) {
+                std::thread t([&] { g(x); });
+                t.join();
+                BOOST_TEST(r.flush());
+            }
+        }
+        #if     !defined(BOOST_CONTRACT_NO_CONDITIONS) && \
+                !defined(BOOST_NO_CXX11_HDR_CHRONO)
+            BOOST_TEST(contains(read(path), "\"tid\":2,")); // First thread's.
+            BOOST_TEST(!contains(read(path), "\"tid\":3,"));
+        #endif
+        std::remove(path.c_str());
+    #endif
+
+    return boost::report_errors();
+}
+
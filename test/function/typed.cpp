@@ -0,0 +1,178 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test free function statically typed contracts.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/typed_function.hpp>
+#include <boost/contract/function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+boost::contract::test::detail::oteststream out;
+
+struct err {}; // Global decl so visible in MSVC10 lambdas.
+
+void g() {
+    boost::contract::check c = boost::contract::function()
+        .precondition([] { out << "g::pre" << std::endl; })
+        .postcondition([] { out << "g::post" << std::endl; })
+    ;
+    out << "g::body" << std::endl;
+}
+
+int f(int& x, bool throw_body) {
+    int result = 0;
+    boost::contract::old_ptr<int> old_x;
+    auto c = boost::contract::typed_function()
+        .precondition([&] {
+            out << "f::pre" << std::endl;
+            g(); // Test no nested contract checking.
+            BOOST_CONTRACT_ASSERT(x >= 0);
+        })
+        .old([&] {
+            out << "f::old" << std::endl;
+            old_x = BOOST_CONTRACT_OLDOF(x);
+        })
+        .postcondition([&] {
+            out << "f::post" << std::endl;
+            BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+            BOOST_CONTRACT_ASSERT(result == *old_x);
+        })
+        .except([&] {
+            out << "f::except" << std::endl;
+            BOOST_CONTRACT_ASSERT(x == *old_x);
+        })
+    ;
+    out << "f::body" << std::endl;
+    if(throw_body) throw err();
+    result = x++;
+    return result;
+}
+
+void h() {
+    auto c = boost::contract::typed_function()
+        .postcondition([] { out << "h::post" << std::endl; })
+    ;
+    out << "h::body" << std::endl;
+}
+
+int main() {
+    std::ostringstream ok;
+
+    int x = 0;
+    out.str("");
+    BOOST_TEST_EQ(f(x, false), 0);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+            #ifdef BOOST_CONTRACT_PRECONDITIONS_DISABLE_NO_ASSERTION
+                << "g::pre" << std::endl
+                << "g::body" << std::endl
+                << "g::post" << std::endl
+            #else
+                << "g::body" << std::endl
+            #endif
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            << "f::old" << std::endl
+        #endif
+        << "f::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "f::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(x, 1);
+
+    out.str("");
+    try {
+        f(x, true);
+        BOOST_TEST(false);
+    } catch(err const&) {
+        ok.str(""); ok
+            #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                << "f::pre" << std::endl
+                #ifdef BOOST_CONTRACT_PRECONDITIONS_DISABLE_NO_ASSERTION
+                    << "g::pre" << std::endl
+                    << "g::body" << std::endl
+                    << "g::post" << std::endl
+                #else
+                    << "g::body" << std::endl
+                #endif
+            #endif
+            #ifndef BOOST_CONTRACT_NO_OLDS
+                << "f::old" << std::endl
+            #endif
+            << "f::body" << std::endl
+            #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                << "f::except" << std::endl
+            #endif
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+    } catch(...) { BOOST_TEST(false); }
+
+    out.str("");
+    h();
+    ok.str(""); ok
+        << "h::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "h::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    // Failed precondition (handler does not throw) skips olds and posts.
+    boost::contract::set_precondition_failure([] (boost::contract::from) {
+        out << "pre_failure" << std::endl;
+    });
+    x = -1;
+    out.str("");
+    f(x, false);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "f::pre" << std::endl
+            #ifdef BOOST_CONTRACT_PRECONDITIONS_DISABLE_NO_ASSERTION
+                << "g::pre" << std::endl
+                << "g::body" << std::endl
+                << "g::post" << std::endl
+            #else
+                << "g::body" << std::endl
+            #endif
+            << "pre_failure" << std::endl
+            << "f::body" << std::endl
+        #else
+            #ifndef BOOST_CONTRACT_NO_OLDS
+                << "f::old" << std::endl
+            #endif
+            << "f::body" << std::endl
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                << "f::post" << std::endl
+            #endif
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    // Failed postcondition.
+    boost::contract::set_postcondition_failure([] (boost::contract::from) {
+        throw err();
+    });
+    auto fail_post = [] {
+        auto c = boost::contract::typed_function()
+            .postcondition([] { BOOST_CONTRACT_ASSERT(false); });
+    };
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_THROWS(fail_post(), err);
+    #else
+        fail_post();
+    #endif
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,158 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test entry invariants skipped for objects not changed since exit invariants.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+boost::contract::test::detail::oteststream out;
+
+class a : private boost::contract::invariant_epoch {
+    friend class boost::contract::access;
+
+    static void static_invariant() { out << "a::static_inv" << std::endl; }
+    void invariant() const { out << "a::inv" << std::endl; }
+
+public:
+    a() : x_(0) {
+        boost::contract::check c = boost::contract::constructor(this);
+        out << "a::ctor::body" << std::endl;
+    }
+
+    int get() const {
+        boost::contract::check c = boost::contract::public_function(this);
+        out << "a::get::body" << std::endl;
+        return x_;
+    }
+
+    void set(int x) {
+        boost::contract::check c = boost::contract::public_function(this);
+        out << "a::set::body" << std::endl;
+        x_ = x;
+        get(); // Test nested call after change checks its entry inv.
+    }
+
+    void set_unchecked(int x) { // Test change not via public functions.
+        x_ = x;
+        bump();
+    }
+
+private:
+    int x_;
+};
+
+std::string ok_inv(bool non_static = true) {
+    std::ostringstream ok; ok << "a::static_inv" << std::endl;
+    if(non_static) ok << "a::inv" << std::endl;
+    return ok.str();
+}
+
+int main() {
+    std::ostringstream ok;
+
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            bool const skip = true;
+        #else
+            bool const skip = false; // Never skipped if no exit inv.
+        #endif
+    #endif
+
+    out.str("");
+    a aa;
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv(false)
+        #endif
+        << "a::ctor::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << ok_inv()
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    for(int i = 0; i < 2; ++i) { // Test const calls never change epoch.
+        out.str("");
+        aa.get();
+        ok.str(""); ok
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << ok_inv(!skip) // Checked at ctor (or get) exit.
+            #endif
+            << "a::get::body" << std::endl
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << ok_inv()
+            #endif
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+    }
+
+    out.str("");
+    aa.set(1);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv(!skip) // Checked at get exit.
+        #endif
+        << "a::set::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv() // Changed by set body.
+        #endif
+        << "a::get::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << ok_inv()
+            << ok_inv() // Changed by set body (also after nested get).
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    out.str("");
+    aa.get();
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv(!skip) // Checked at set exit.
+        #endif
+        << "a::get::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << ok_inv()
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    aa.set_unchecked(2);
+    out.str("");
+    BOOST_TEST_EQ(aa.get(), 2);
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv() // Changed by set_unchecked.
+        #endif
+        << "a::get::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << ok_inv()
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    out.str("");
+    a cc(aa); // Test copy not checked yet (and no contract for copy ctor).
+    cc.get();
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv()
+        #endif
+        << "a::get::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << ok_inv()
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    return boost::report_errors();
+}
+
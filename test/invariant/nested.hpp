@@ -0,0 +1,227 @@
+
+// no #include guard
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test invariants for nested calls on same object (skipped if NO_NESTED_INV).
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/destructor.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+
+boost::contract::test::detail::oteststream out;
+
+struct a {
+    static void static_invariant() { out << "a::static_inv" << std::endl; }
+    void invariant() const { out << "a::inv" << std::endl; }
+
+    a() {
+        boost::contract::check c = boost::contract::constructor(this);
+        out << "a::ctor::body" << std::endl;
+        g(); // Test nested call from ctor.
+    }
+
+    virtual ~a() {
+        boost::contract::check c = boost::contract::destructor(this);
+        out << "a::dtor::body" << std::endl;
+        g(); // Test nested call from dtor.
+    }
+
+    void f(a& other) {
+        boost::contract::check c = boost::contract::public_function(this);
+        out << "a::f::body" << std::endl;
+        g(); // Test nested call on same object.
+        other.g(); // Test nested call on other object.
+    }
+
+    void g() const {
+        boost::contract::check c = boost::contract::public_function(this)
+            .precondition([] { out << "a::g::pre" << std::endl; })
+        ;
+        out << "a::g::body" << std::endl;
+    }
+};
+
+struct b {
+    static void static_invariant() { out << "b::static_inv" << std::endl; }
+    void invariant() const { out << "b::inv" << std::endl; }
+
+    virtual void h(boost::contract::virtual_* v = 0) {
+        boost::contract::check c = boost::contract::public_function(v, this);
+        out << "b::h::body" << std::endl;
+    }
+
+    virtual ~b() {}
+};
+
+struct d {
+    static void static_invariant() { out << "d::static_inv" << std::endl; }
+    void invariant() const { out << "d::inv" << std::endl; }
+
+    void k() {
+        boost::contract::check c = boost::contract::public_function(this);
+        out << "d::k::body" << std::endl;
+    }
+
+    virtual ~d() {}
+};
+
+struct e
+    #define BASES public b, public d
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    static void static_invariant() { out << "e::static_inv" << std::endl; }
+    void invariant() const { out << "e::inv" << std::endl; }
+
+    void f() {
+        boost::contract::check c = boost::contract::public_function(this);
+        out << "e::f::body" << std::endl;
+        h(); // Test nested call to override (also base inv skipped).
+        k(); // Test nested call via other base subobject (multiple inh.).
+    }
+
+    virtual void h(boost::contract::virtual_* v = 0) /* override */ {
+        boost::contract::check c = boost::contract::public_function<
+                override_h>(v, &e::h, this);
+        out << "e::h::body" << std::endl;
+    }
+    BOOST_CONTRACT_OVERRIDE(h)
+};
+
+std::string ok_inv(bool non_static = true, std::string const& cls = "a") {
+    std::ostringstream ok; ok << cls << "::static_inv" << std::endl;
+    if(non_static) ok << cls << "::inv" << std::endl;
+    return ok.str();
+}
+
+std::string ok_g(bool inv) {
+    std::ostringstream ok;
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        if(inv) ok << ok_inv();
+    #endif
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        ok << "a::g::pre" << std::endl;
+    #endif
+    ok << "a::g::body" << std::endl;
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        if(inv) ok << ok_inv();
+    #endif
+    return ok.str();
+}
+
+std::string ok_h(bool inv) {
+    std::ostringstream ok;
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        if(inv) ok << ok_inv(true, "b") << ok_inv(true, "e");
+    #endif
+    ok << "e::h::body" << std::endl;
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        if(inv) ok << ok_inv(true, "b") << ok_inv(true, "e");
+    #endif
+    return ok.str();
+}
+
+std::string ok_k(bool inv) {
+    std::ostringstream ok;
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        if(inv) ok << ok_inv(true, "d");
+    #endif
+    ok << "d::k::body" << std::endl;
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        if(inv) ok << ok_inv(true, "d");
+    #endif
+    return ok.str();
+}
+
+int main() {
+    std::ostringstream ok;
+    #ifdef BOOST_CONTRACT_NO_NESTED_INVARIANTS
+        bool const nested_inv = false;
+    #else
+        bool const nested_inv = true;
+    #endif
+
+    {
+        out.str("");
+        a aa;
+        ok.str(""); ok
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << ok_inv(false)
+            #endif
+            << "a::ctor::body" << std::endl
+            << ok_g(nested_inv)
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << ok_inv()
+            #endif
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+
+        a bb;
+        out.str("");
+        aa.f(bb);
+        ok.str(""); ok
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << ok_inv()
+            #endif
+            << "a::f::body" << std::endl
+            << ok_g(nested_inv)
+            << ok_g(true) // Other object always checks inv.
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << ok_inv()
+            #endif
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+
+        out.str("");
+        aa.g(); // Test not nested after outer calls exit.
+        BOOST_TEST(out.eq(ok_g(true)));
+
+        out.str("");
+    } // Call dtors of bb and then aa.
+    ok.str("");
+    for(int i = 0; i < 2; ++i) {
+        ok
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << ok_inv()
+            #endif
+            << "a::dtor::body" << std::endl
+            << ok_g(nested_inv)
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << ok_inv(false)
+            #endif
+        ;
+    }
+    BOOST_TEST(out.eq(ok.str()));
+
+    e ee;
+    out.str("");
+    ee.f();
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << ok_inv(true, "e")
+        #endif
+        << "e::f::body" << std::endl
+        << ok_h(nested_inv) // Base inv also skipped (subcontracting).
+        << ok_k(nested_inv) // Same object also via other base subobject.
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << ok_inv(true, "e")
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,13 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test invariants not checked for nested calls on same object.
+
+#ifndef BOOST_CONTRACT_NO_NESTED_INVARIANTS
+    #error "build must define NO_NESTED_INVARIANTS"
+#endif
+#include "nested.hpp"
+
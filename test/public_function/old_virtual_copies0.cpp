@@ -0,0 +1,12 @@
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test with number of old copies held in place set to 0 (so queues overflow).
+
+#if !defined(BOOST_CONTRACT_OLD_COPIES) || BOOST_CONTRACT_OLD_COPIES != 0
+    #error "build must define OLD_COPIES=0"
+#endif
+#include "old_virtual.hpp"
+
@@ -0,0 +1,162 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test overrides checked only for sampled calls (but always subcontracting).
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/sample.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+boost::contract::test::detail::oteststream out;
+
+struct policy {
+    char const* name;
+    bool check;
+    bool operator()() const {
+        out << name << "::policy" << std::endl;
+        return check;
+    }
+};
+
+policy pb = {"b", true};
+policy pa = {"a", true};
+
+struct b {
+    static void static_invariant() { out << "b::static_inv" << std::endl; }
+    void invariant() const { out << "b::inv" << std::endl; }
+
+    int x;
+    b() : x(0) {}
+
+    virtual void f(boost::contract::virtual_* v = 0) {
+        boost::contract::sample sampled(pb, v);
+        boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(v, x);
+        boost::contract::check c = boost::contract::public_function(v, this)
+            .precondition([] { out << "b::f::pre" << std::endl; })
+            .old([] { out << "b::f::old" << std::endl; })
+            .postcondition([&] {
+                out << "b::f::post" << std::endl;
+                BOOST_CONTRACT_ASSERT(old_x); // Old copied if post checked.
+                BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+            })
+        ;
+        out << "b::f::body" << std::endl;
+        ++x;
+    }
+};
+
+struct a
+    #define BASES public b
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    static void static_invariant() { out << "a::static_inv" << std::endl; }
+    void invariant() const { out << "a::inv" << std::endl; }
+
+    virtual void f(boost::contract::virtual_* v = 0) /* override */ {
+        boost::contract::sample sampled(pa, v);
+        boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(v, x);
+        boost::contract::check c = boost::contract::public_function<override_f>(
+                v, &a::f, this)
+            .precondition([] { out << "a::f::pre" << std::endl; })
+            .old([] { out << "a::f::old" << std::endl; })
+            .postcondition([&] {
+                out << "a::f::post" << std::endl;
+                BOOST_CONTRACT_ASSERT(old_x); // Old copied if post checked.
+                BOOST_CONTRACT_ASSERT(x == *old_x + 1);
+            })
+        ;
+        out << "a::f::body" << std::endl;
+        ++x;
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+int main() {
+    std::ostringstream ok;
+    a aa;
+    b& ba = aa; // Test polymorphic calls.
+
+    // Sampled in: Derived and base contracts checked (base policy not called).
+    pa.check = true;
+    pb.check = false;
+    out.str("");
+    ba.f();
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "a::policy" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+            << "b::static_inv" << std::endl
+            << "b::inv" << std::endl
+            << "a::static_inv" << std::endl
+            << "a::inv" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+            << "b::f::pre" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            << "b::f::old" << std::endl
+            << "a::f::old" << std::endl
+        #endif
+        << "a::f::body" << std::endl
+        #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+            << "b::static_inv" << std::endl
+            << "b::inv" << std::endl
+            << "a::static_inv" << std::endl
+            << "a::inv" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_OLDS
+            << "b::f::old" << std::endl
+        #endif
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            << "b::f::post" << std::endl
+            << "a::f::post" << std::endl
+        #endif
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(aa.x, 1);
+
+    // Sampled out: Neither derived nor base contracts checked.
+    pa.check = false;
+    pb.check = true;
+    out.str("");
+    ba.f();
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "a::policy" << std::endl
+        #endif
+        << "a::f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(aa.x, 2);
+
+    // Base called directly uses its own policy.
+    b bb;
+    pb.check = false;
+    out.str("");
+    bb.f();
+    ok.str(""); ok
+        #ifndef BOOST_CONTRACT_NO_CONDITIONS
+            << "b::policy" << std::endl
+        #endif
+        << "b::f::body" << std::endl
+    ;
+    BOOST_TEST(out.eq(ok.str()));
+    BOOST_TEST_EQ(bb.x, 1);
+
+    return boost::report_errors();
+}
+
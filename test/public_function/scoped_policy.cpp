@@ -0,0 +1,186 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test scoped policies change conditions checked by current thread only.
+
+#include "../detail/oteststream.hpp"
+#include <boost/contract/scoped_policy.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/contract/old.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+
+boost::contract::test::detail::oteststream out;
+
+struct a {
+    void invariant() const { out << "a::inv" << std::endl; }
+
+    void f(bool fail = false) {
+        boost::contract::old_ptr<int> old_x = BOOST_CONTRACT_OLDOF(x_);
+        boost::contract::check c = boost::contract::public_function(this)
+            .precondition([] {
+                out << "a::f::pre" << std::endl;
+                BOOST_CONTRACT_ASSERT_AUDIT(
+                        (out << "a::f::pre_audit" << std::endl, true));
+            })
+            .old([] { out << "a::f::old" << std::endl; })
+            .postcondition([&] {
+                out << "a::f::post" << std::endl;
+                BOOST_CONTRACT_ASSERT(*old_x == x_); // Old copied if post.
+            })
+            .except([&] {
+                out << "a::f::except" << std::endl;
+                BOOST_CONTRACT_ASSERT(*old_x == x_); // Old copied if except.
+            })
+        ;
+        out << "a::f::body" << std::endl;
+        if(fail) throw int(0);
+    }
+
+    a() : x_(0) {}
+
+private:
+    int x_;
+};
+
+std::string ok_f(unsigned checked, bool audit = false, bool fail = false) {
+    std::ostringstream ok;
+    #ifdef BOOST_CONTRACT_AUDITS
+        audit = true; // Always checked.
+    #endif
+    #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+        if(checked & boost::contract::checked_entry_invariants) {
+            ok << "a::inv" << std::endl;
+        }
+    #endif
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        if(checked & boost::contract::checked_preconditions) {
+            ok << "a::f::pre" << std::endl;
+            if(audit) ok << "a::f::pre_audit" << std::endl;
+        }
+    #endif
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        if(checked & (boost::contract::checked_postconditions |
+                boost::contract::checked_excepts)) {
+            ok << "a::f::old" << std::endl;
+        }
+    #endif
+    ok << "a::f::body" << std::endl;
+    #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+        if(checked & boost::contract::checked_exit_invariants) {
+            ok << "a::inv" << std::endl;
+        }
+    #endif
+    if(fail) {
+        #ifndef BOOST_CONTRACT_NO_EXCEPTS
+            if(checked & boost::contract::checked_excepts) {
+                ok << "a::f::except" << std::endl;
+            }
+        #endif
+    } else {
+        #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+            if(checked & boost::contract::checked_postconditions) {
+                ok << "a::f::post" << std::endl;
+            }
+        #endif
+    }
+    return ok.str();
+}
+
+int main() {
+    a aa;
+
+    out.str("");
+    aa.f();
+    BOOST_TEST(out.eq(ok_f(boost::contract::checked_all)));
+
+    {
+        boost::contract::scoped_policy p(boost::contract::checked_none);
+        out.str("");
+        aa.f();
+        BOOST_TEST(out.eq(ok_f(boost::contract::checked_none)));
+
+        { // Test nested policies.
+            boost::contract::scoped_policy q(boost::contract::checked_all,
+                    boost::contract::assertion_level_audit);
+            BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+                    boost::contract::assertion_level_audit);
+            out.str("");
+            aa.f();
+            BOOST_TEST(out.eq(ok_f(boost::contract::checked_all, true)));
+
+            #ifndef BOOST_CONTRACT_DISABLE_THREADS
+                // Test other threads not affected.
+                std::thread t([&] {
+                    BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+                            boost::contract::assertion_level_default);
+                });
+                t.join();
+            #endif
+        }
+        
+        { // Test level only (conditions kept).
+            boost::contract::scoped_policy q(
+                    boost::contract::assertion_level_audit);
+            BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+                    boost::contract::assertion_level_audit);
+            out.str("");
+            aa.f();
+            BOOST_TEST(out.eq(ok_f(boost::contract::checked_none)));
+        }
+        
+        out.str("");
+        aa.f();
+        BOOST_TEST(out.eq(ok_f(boost::contract::checked_none)));
+    }
+    BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+            boost::contract::assertion_level_default);
+
+    {
+        boost::contract::scoped_policy p(boost::contract::checked_preconditions |
+                boost::contract::checked_exit_invariants);
+        out.str("");
+        aa.f();
+        BOOST_TEST(out.eq(ok_f(boost::contract::checked_preconditions |
+                boost::contract::checked_exit_invariants)));
+    }
+
+    {
+        boost::contract::scoped_policy p(boost::contract::checked_excepts);
+        out.str("");
+        try {
+            aa.f(true);
+            BOOST_TEST(false);
+        } catch(int) {}
+        BOOST_TEST(out.eq(ok_f(boost::contract::checked_excepts, false,
+                true)));
+        
+        out.str("");
+        aa.f(); // Test old values copied for except but post not checked.
+        BOOST_TEST(out.eq(ok_f(boost::contract::checked_excepts)));
+    }
+
+    {
+        boost::contract::scoped_policy p(
+                boost::contract::assertion_level_audit);
+        out.str("");
+        aa.f();
+        BOOST_TEST(out.eq(ok_f(boost::contract::checked_all, true)));
+    }
+    BOOST_TEST_EQ(boost::contract::get_assertion_level(),
+            boost::contract::assertion_level_default);
+
+    out.str("");
+    aa.f();
+    BOOST_TEST(out.eq(ok_f(boost::contract::checked_all)));
+
+    return boost::report_errors();
+}
+
@@ -0,0 +1,160 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test single-pass subcontracting (each base checks exit inv and post/except in
+// one call, and pushes old values at body while checking entry inv).
+
+#ifndef BOOST_CONTRACT_SINGLE_PASS_SUBCONTRACTING
+    #error "build must define BOOST_CONTRACT_SINGLE_PASS_SUBCONTRACTING"
+#endif
+
+#include "smoke.hpp"
+#include <boost/optional.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <sstream>
+
+int main() {
+    std::ostringstream ok;
+
+    #ifndef BOOST_CONTRACT_NO_OLDS
+        #define BOOST_CONTRACT_TEST_old 1u
+    #else
+        #define BOOST_CONTRACT_TEST_old 0u
+    #endif
+
+    {
+        c cc;
+        s_type s; s.value = "C";
+        out.str("");
+        result_type& r = cc.f(s);
+        ok.str(""); ok
+            #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                << "d::static_inv" << std::endl
+                << "d::inv" << std::endl
+                << "e::static_inv" << std::endl
+                << "e::inv" << std::endl
+                << "c::static_inv" << std::endl
+                << "c::inv" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                << "d::f::pre" << std::endl
+                << "e::f::pre" << std::endl
+                << "c::f::pre" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_OLDS
+                << "d::f::old" << std::endl
+                << "e::f::old" << std::endl
+                << "c::f::old" << std::endl
+            #endif
+            << "c::f::body" << std::endl
+            // Each base checks its exit inv and post together.
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << "d::static_inv" << std::endl
+                << "d::inv" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                << "d::f::old" << std::endl
+                << "d::f::post" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << "e::static_inv" << std::endl
+                << "e::inv" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                << "e::f::old" << std::endl
+                << "e::f::post" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                << "c::static_inv" << std::endl
+                << "c::inv" << std::endl
+            #endif
+            #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+                // No old call here because not a base object.
+                << "c::f::post" << std::endl
+            #endif
+        ;
+        BOOST_TEST(out.eq(ok.str()));
+
+        BOOST_TEST_EQ(r.value, "C");
+        BOOST_TEST_EQ(s.value, "cde");
+        BOOST_TEST_EQ(s.copies(), BOOST_CONTRACT_TEST_old * 3);
+        BOOST_TEST_EQ(s.evals(), BOOST_CONTRACT_TEST_old * 3);
+
+        BOOST_TEST_EQ(cc.t<'d'>::z.value, "dC");
+        BOOST_TEST_EQ(cc.t<'d'>::z.copies(), BOOST_CONTRACT_TEST_old);
+        BOOST_TEST_EQ(cc.t<'d'>::z.evals(), BOOST_CONTRACT_TEST_old);
+
+        BOOST_TEST_EQ(cc.t<'e'>::z.value, "eC");
+        BOOST_TEST_EQ(cc.t<'e'>::z.copies(), BOOST_CONTRACT_TEST_old);
+        BOOST_TEST_EQ(cc.t<'e'>::z.evals(), BOOST_CONTRACT_TEST_old);
+    }
+
+    {
+        c cc;
+        s_type s; s.value = "X"; // So body will throw.
+        out.str("");
+        boost::optional<result_type&> r;
+        try {
+            r = cc.f(s);
+            BOOST_TEST(false);
+        } catch(except_error const&) {
+            ok.str(""); ok
+                #ifndef BOOST_CONTRACT_NO_ENTRY_INVARIANTS
+                    << "d::static_inv" << std::endl
+                    << "d::inv" << std::endl
+                    << "e::static_inv" << std::endl
+                    << "e::inv" << std::endl
+                    << "c::static_inv" << std::endl
+                    << "c::inv" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+                    << "d::f::pre" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_OLDS
+                    << "d::f::old" << std::endl
+                    << "e::f::old" << std::endl
+                    << "c::f::old" << std::endl
+                #endif
+                << "c::f::body" << std::endl
+                // Each base checks its exit inv and except together.
+                #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                    << "d::static_inv" << std::endl
+                    << "d::inv" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                    << "d::f::old" << std::endl
+                    << "d::f::except" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                    << "e::static_inv" << std::endl
+                    << "e::inv" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                    << "e::f::old" << std::endl
+                    << "e::f::except" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_EXIT_INVARIANTS
+                    << "c::static_inv" << std::endl
+                    << "c::inv" << std::endl
+                #endif
+                #ifndef BOOST_CONTRACT_NO_EXCEPTS
+                    // No old call here because not a base object.
+                    << "c::f::except" << std::endl
+                #endif
+            ;
+            BOOST_TEST(out.eq(ok.str()));
+
+            BOOST_TEST(!r); // Boost.Optional result not init (as body threw).
+            BOOST_TEST_EQ(s.value, "X");
+            BOOST_TEST_EQ(cc.t<'d'>::z.value, "d");
+            BOOST_TEST_EQ(cc.t<'e'>::z.value, "e");
+        }
+    }
+
+    #undef BOOST_CONTRACT_TEST_old
+    return boost::report_errors();
+}
+
@@ -0,0 +1,59 @@
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test override public function run-time error on base result type mismatch.
+
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/override.hpp>
+#include <boost/contract/base_types.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/core/exception.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+struct b {
+    virtual int f(boost::contract::virtual_* v = 0) {
+        // Cannot error at compile-time (public_function does not take &b::f).
+        char result = 0;
+        boost::contract::check c = boost::contract::public_function(
+                v, result, this)
+            .postcondition([] (char const&) {})
+        ;
+        return result;
+    }
+};
+
+struct a
+    #define BASES public b
+    : BASES
+{
+    typedef BOOST_CONTRACT_BASE_TYPES(BASES) base_types;
+    #undef BASES
+
+    virtual int f(boost::contract::virtual_* v = 0) /* override */ {
+        int result = 0;
+        boost::contract::check c = boost::contract::public_function<override_f>(
+                v, result, &a::f, this); // OK, but b::f result mismatches.
+        return result;
+    }
+    BOOST_CONTRACT_OVERRIDE(f)
+};
+
+int main() {
+    boost::contract::set_postcondition_failure([] (boost::contract::from) {
+        throw; // Re-throw bad_virtual_result_cast.
+    });
+
+    a aa;
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_THROWS(aa.f(), boost::contract::bad_virtual_result_cast);
+    #else
+        BOOST_TEST_EQ(aa.f(), 0);
+    #endif
+
+    b bb; // No subcontracting, so no mismatch.
+    BOOST_TEST_EQ(bb.f(), 0);
+    return boost::report_errors();
+}
+
@@ -0,0 +1,135 @@
+
+// Copyright (C) 2008-2018 Lorenzo Caminiti
+// Distributed under the Boost Software License, Version 1.0 (see accompanying
+// file LICENSE_1_0.txt or a copy at http://www.boost.org/LICENSE_1_0.txt).
+// See: http://www.boost.org/doc/libs/release/libs/contract/doc/html/index.html
+
+// Test contracts and their functors not allocated on heap (unless they do not
+// fit check and functor buffers respectively).
+
+#include <boost/contract/function.hpp>
+#include <boost/contract/public_function.hpp>
+#include <boost/contract/constructor.hpp>
+#include <boost/contract/destructor.hpp>
+#include <boost/contract/check.hpp>
+#include <boost/contract/assert.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <cstdlib>
+#include <new>
+
+unsigned allocs = 0;
+
+void* operator new(std::size_t size) {
+    ++allocs;
+    if(void* ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) BOOST_NOEXCEPT { std::free(ptr); }
+
+unsigned pres = 0, posts = 0;
+
+void f(int x) {
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { ++pres; BOOST_CONTRACT_ASSERT(x >= 0); })
+        .postcondition([&] { ++posts; })
+        .except([&] {})
+    ;
+}
+
+void e(int x1, int x2, int x3, int x4, int x5, int x6) {
+    boost::contract::check c = boost::contract::function()
+        .precondition([&] { // Six captures by ref fit functor buffer.
+            ++pres;
+            BOOST_CONTRACT_ASSERT(x1 + x2 + x3 + x4 + x5 + x6 >= 0);
+        })
+    ;
+}
+
+struct copied { // Copies check f's contract (while specifying other contracts).
+    copied() {}
+    copied(copied const&) { f(1); }
+};
+
+unsigned k_pres = 0;
+
+void k(copied const& y) {
+    boost::contract::check c = boost::contract::function()
+        .precondition([y] { ++k_pres; })
+    ;
+}
+
+struct big { char data[BOOST_CONTRACT_CHECK_BUFFER_SIZE + 1]; };
+
+void g(big const& b) {
+    boost::contract::check c = boost::contract::function()
+        .precondition([b] { ++pres; BOOST_CONTRACT_ASSERT(b.data[0] == 0); })
+    ;
+}
+
+struct a {
+    static void static_invariant() {}
+    void invariant() const {}
+
+    a() {
+        boost::contract::check c = boost::contract::constructor(this)
+            .postcondition([&] { ++posts; })
+        ;
+    }
+
+    ~a() {
+        boost::contract::check c = boost::contract::destructor(this)
+            .postcondition([&] { ++posts; })
+        ;
+    }
+
+    void h(int x) {
+        boost::contract::check c = boost::contract::public_function(this)
+            .precondition([&] { ++pres; BOOST_CONTRACT_ASSERT(x >= 0); })
+            .postcondition([&] { ++posts; })
+        ;
+    }
+
+    static void s() {
+        boost::contract::check c = boost::contract::public_function<a>()
+            .precondition([&] { ++pres; })
+        ;
+    }
+};
+
+int main() {
+    allocs = pres = posts = 0;
+    f(1);
+    e(1, 2, 3, 4, 5, 6);
+    {
+        a aa;
+        aa.h(1);
+        a::s();
+    }
+    BOOST_TEST_EQ(allocs, 0u);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(pres, 4u);
+    #endif
+    #ifndef BOOST_CONTRACT_NO_POSTCONDITIONS
+        BOOST_TEST_EQ(posts, 4u);
+    #endif
+
+    copied y;
+    allocs = k_pres = 0;
+    k(y); // Nested contracts not on heap either.
+    BOOST_TEST_EQ(allocs, 0u);
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST_EQ(k_pres, 1u);
+    #endif
+
+    big b = {};
+    allocs = pres = 0;
+    g(b); // Functor does not fit buffer so on heap, but still checked.
+    #ifndef BOOST_CONTRACT_NO_PRECONDITIONS
+        BOOST_TEST(allocs > 0u);
+        BOOST_TEST_EQ(pres, 1u);
+    #endif
+
+    return boost::report_errors();
+}
+